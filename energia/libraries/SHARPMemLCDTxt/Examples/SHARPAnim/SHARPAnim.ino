@@ -0,0 +1,62 @@
+// Animation example, plays a bouncing ball and reports frame rate and bytes sent
+// to the display over Serial, compared to drawing each frame with bitmap().
+// The animation was created with tools/sharpanim.py from 16 PBM images.
+// Distributed under MIT License, see license.txt for details.
+
+#include <SPI.h>
+#include <SHARPMemLCDTxt.h>
+#include <SHARPMemLCDAnim.h>
+#include "ball.h"
+
+SHARPMemLCDTxt display;       // configured for 43oh BoosterPack
+//SHARPMemLCDTxt display(6,5);  // configured for official TI BoosterPack
+
+SHARPMemLCDAnim animation(display);
+
+unsigned char shadow[PIXELS_X/8 * 24];       // previous frame, 24 lines high
+
+void setup()
+{
+  Serial.begin(9600);
+
+  display.begin(); // configure display
+
+  display.clear();
+  display.on();
+
+  display.print(" ANIMATION  ", 8);
+
+  animation.begin(anim_ball, shadow, 40);
+}
+
+void loop()
+{
+  // decode all frames as fast as possible to measure throughput
+  unsigned long start = millis();
+  unsigned long lines = 0;
+  unsigned int frames = 0;
+  int sent;
+
+  animation.rewind();
+  while ((sent = animation.frame()) >= 0) {
+    lines += sent;
+    frames++;
+  }
+
+  unsigned long time = millis() - start;
+
+  // command and trailer per frame, address, data and dummy per line
+  Serial.print("fps: ");
+  Serial.print(frames * 1000UL / (time ? time : 1));
+  Serial.print(", bytes on wire: ");
+  Serial.print(frames * 2 + lines * (PIXELS_X/8 + 2));
+  Serial.print(", with bitmap(): ");
+  Serial.println(frames * (2 + 24 * (PIXELS_X/8 + 2)));
+
+  // play at the speed of the animation for a few seconds
+  animation.rewind();
+  start = millis();
+  while (millis() - start < 5000) {
+    animation.play(1);
+  }
+}
@@ -0,0 +1,79 @@
+// Animation 96x24px, 16 frames
+static const unsigned char anim_ball[] =
+{
+0x53, 0x41, 0x0c, 0x18, 0x10, 0x00, 0x32, 0x00, 0xff, 0xff, 0xff, 0x00,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x02, 0x00, 0x08, 0x02, 0x00, 0x7f, 0x06, 0x00, 0xff, 0x80, 0x06,
+0x00, 0xff, 0x80, 0x06, 0x00, 0xff, 0x80, 0x07, 0x00, 0x01, 0xff, 0xc0,
+0x06, 0x00, 0xff, 0x80, 0x06, 0x00, 0xff, 0x80, 0x06, 0x00, 0xff, 0x80,
+0x02, 0x00, 0x7f, 0x02, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x00, 0x00, 0x00, 0xff, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf0, 0xff, 0x03, 0x04, 0x00, 0x80,
+0x06, 0x00, 0x07, 0xf0, 0x06, 0x00, 0x0f, 0xf8, 0x06, 0x00, 0x07, 0xf8,
+0x06, 0x00, 0x70, 0xf8, 0x06, 0x00, 0xe0, 0x7c, 0x06, 0x00, 0xf0, 0x78,
+0x06, 0x00, 0xf0, 0x78, 0x07, 0x00, 0x01, 0xf0, 0x38, 0x06, 0x00, 0xf8,
+0x70, 0x02, 0x00, 0xff, 0x06, 0x00, 0xff, 0x80, 0x02, 0x00, 0x7f, 0x02,
+0x00, 0x08, 0xff, 0x7f, 0x00, 0x04, 0x00, 0x04, 0x0c, 0x00, 0x3f, 0x80,
+0x0c, 0x00, 0x7f, 0xc0, 0x0c, 0x00, 0x7f, 0xc0, 0x0c, 0x00, 0xff, 0xc0,
+0x0e, 0x00, 0x07, 0x0f, 0xe0, 0x0e, 0x00, 0x0f, 0x87, 0xc0, 0x0e, 0x00,
+0x0f, 0x87, 0xc0, 0x0e, 0x00, 0x0f, 0x87, 0xc0, 0x0e, 0x00, 0x1f, 0xc3,
+0x80, 0x06, 0x00, 0x0f, 0xfc, 0x06, 0x00, 0x0f, 0xf8, 0x06, 0x00, 0x0f,
+0xf8, 0x06, 0x00, 0x07, 0xf0, 0x04, 0x00, 0x80, 0xff, 0x07, 0x00, 0x0c,
+0x00, 0x07, 0xfe, 0x0c, 0x00, 0x3c, 0x7e, 0x0c, 0x00, 0x7c, 0x3e, 0x0c,
+0x00, 0x78, 0x3f, 0x0c, 0x00, 0x7c, 0x3e, 0x0c, 0x00, 0xfc, 0x1e, 0x0c,
+0x00, 0x7c, 0x3e, 0x0c, 0x00, 0x7e, 0x3c, 0x0c, 0x00, 0x7f, 0xe0, 0x0c,
+0x00, 0x3f, 0x80, 0x04, 0x00, 0x04, 0xff, 0x01, 0x00, 0x1c, 0x00, 0x03,
+0xe1, 0xf0, 0x1c, 0x00, 0x03, 0xe1, 0xf0, 0x1c, 0x00, 0x03, 0xc1, 0xf8,
+0x1c, 0x00, 0x07, 0xe0, 0xf0, 0x1c, 0x00, 0x03, 0xe1, 0xf0, 0x1c, 0x00,
+0x03, 0xe1, 0xf0, 0x1c, 0x00, 0x03, 0xf1, 0xe0, 0x0c, 0x00, 0x01, 0xfd,
+0x08, 0x00, 0x20, 0xff, 0x01, 0x00, 0x38, 0x00, 0x1f, 0x0f, 0x80, 0x38,
+0x00, 0x1f, 0x0f, 0x80, 0x38, 0x00, 0x3f, 0x07, 0x80, 0x38, 0x00, 0x1e,
+0x0f, 0xc0, 0x38, 0x00, 0x1f, 0x0f, 0x80, 0x38, 0x00, 0x1f, 0x0f, 0x80,
+0x38, 0x00, 0x0f, 0x1f, 0x80, 0x18, 0x00, 0x01, 0x7f, 0x10, 0x00, 0x08,
+0xff, 0x07, 0x00, 0x10, 0x00, 0xff, 0x30, 0x00, 0xf8, 0x70, 0x30, 0x00,
+0xf0, 0x78, 0x38, 0x00, 0x01, 0xf0, 0x38, 0x30, 0x00, 0xf0, 0x78, 0x30,
+0x00, 0xe0, 0x7c, 0x30, 0x00, 0xf0, 0x78, 0x30, 0x00, 0x70, 0xf8, 0x30,
+0x00, 0x07, 0xf8, 0x30, 0x00, 0x07, 0xf0, 0x20, 0x00, 0x80, 0xff, 0x7f,
+0x00, 0x20, 0x00, 0x80, 0x30, 0x00, 0x07, 0xf0, 0x30, 0x00, 0x0f, 0xf8,
+0x30, 0x00, 0x0f, 0xf8, 0x30, 0x00, 0x0f, 0xfc, 0x70, 0x00, 0x1f, 0xc3,
+0x80, 0x70, 0x00, 0x0f, 0x87, 0xc0, 0x70, 0x00, 0x0f, 0x87, 0xc0, 0x70,
+0x00, 0x0f, 0x87, 0xc0, 0x70, 0x00, 0x07, 0x0f, 0xe0, 0x60, 0x00, 0xff,
+0xc0, 0x60, 0x00, 0x7f, 0xc0, 0x60, 0x00, 0x7f, 0xc0, 0x60, 0x00, 0x3f,
+0x80, 0x20, 0x00, 0x04, 0xf0, 0xff, 0x03, 0x20, 0x00, 0x04, 0x60, 0x00,
+0x3f, 0x80, 0x60, 0x00, 0x7f, 0xc0, 0x60, 0x00, 0x7f, 0xe0, 0x60, 0x00,
+0x7e, 0x3c, 0x60, 0x00, 0xfc, 0x1e, 0x60, 0x00, 0x7c, 0x3e, 0x60, 0x00,
+0x7c, 0x3e, 0x60, 0x00, 0x78, 0x3f, 0x60, 0x00, 0x3c, 0x7e, 0x60, 0x00,
+0x07, 0xfe, 0x60, 0x00, 0x03, 0xfe, 0x60, 0x00, 0x01, 0xfc, 0x40, 0x00,
+0x20, 0xf0, 0xff, 0x03, 0x40, 0x00, 0x01, 0xc0, 0x00, 0x0f, 0xe0, 0xc0,
+0x00, 0x1f, 0xf0, 0xc0, 0x00, 0x3f, 0xf0, 0xe0, 0x00, 0x01, 0xe3, 0xf0,
+0xe0, 0x00, 0x03, 0xc1, 0xf8, 0xe0, 0x00, 0x03, 0xe1, 0xf0, 0xe0, 0x00,
+0x03, 0xe1, 0xf0, 0xe0, 0x00, 0x07, 0xe0, 0xf0, 0xe0, 0x00, 0x03, 0xf1,
+0xe0, 0x60, 0x00, 0x03, 0xff, 0x60, 0x00, 0x03, 0xfe, 0x60, 0x00, 0x01,
+0xfc, 0x40, 0x00, 0x20, 0xff, 0x7f, 0x00, 0x80, 0x00, 0x08, 0x80, 0x00,
+0x7f, 0x80, 0x01, 0xff, 0x80, 0x80, 0x01, 0xff, 0x80, 0xc0, 0x01, 0x01,
+0xff, 0x80, 0xc0, 0x01, 0x0e, 0x1f, 0xc0, 0xc0, 0x01, 0x1f, 0x0f, 0x80,
+0xc0, 0x01, 0x1f, 0x0f, 0x80, 0xc0, 0x01, 0x1f, 0x0f, 0x80, 0xc0, 0x00,
+0x3f, 0x87, 0xc0, 0x00, 0x1f, 0xf8, 0xc0, 0x00, 0x1f, 0xf0, 0xc0, 0x00,
+0x1f, 0xf0, 0xc0, 0x00, 0x0f, 0xe0, 0x40, 0x00, 0x01, 0xff, 0x07, 0x00,
+0x80, 0x01, 0x07, 0xf8, 0x80, 0x01, 0x70, 0xf8, 0x80, 0x01, 0xf0, 0x78,
+0x80, 0x01, 0xe0, 0x7c, 0x80, 0x01, 0xf0, 0x78, 0xc0, 0x01, 0x01, 0xf0,
+0x38, 0x80, 0x01, 0xf0, 0x78, 0x80, 0x01, 0xf8, 0x70, 0x80, 0x00, 0xff,
+0x80, 0x00, 0x7f, 0x80, 0x00, 0x08, 0xff, 0x01, 0x00, 0x80, 0x03, 0x0f,
+0x87, 0xc0, 0x80, 0x03, 0x0f, 0x87, 0xc0, 0x80, 0x03, 0x0f, 0x07, 0xe0,
+0x80, 0x03, 0x1f, 0x83, 0xc0, 0x80, 0x03, 0x0f, 0x87, 0xc0, 0x80, 0x03,
+0x0f, 0x87, 0xc0, 0x80, 0x03, 0x0f, 0xc7, 0x80, 0x80, 0x01, 0x07, 0xf4,
+0x00, 0x01, 0x80, 0xff, 0x01, 0x00, 0x00, 0x03, 0x7c, 0x3e, 0x00, 0x03,
+0x7c, 0x3e, 0x00, 0x03, 0xfc, 0x1e, 0x00, 0x03, 0x78, 0x3f, 0x00, 0x03,
+0x7c, 0x3e, 0x00, 0x03, 0x7c, 0x3e, 0x00, 0x03, 0x3c, 0x7e, 0x00, 0x03,
+0x05, 0xfc, 0x00, 0x02, 0x20, 0xff, 0x07, 0x00, 0x00, 0x03, 0x03, 0xff,
+0x00, 0x07, 0x03, 0xf1, 0xe0, 0x00, 0x07, 0x03, 0xe1, 0xf0, 0x00, 0x07,
+0x07, 0xe0, 0xf0, 0x00, 0x07, 0x03, 0xe1, 0xf0, 0x00, 0x07, 0x03, 0xc1,
+0xf8, 0x00, 0x07, 0x03, 0xe1, 0xf0, 0x00, 0x07, 0x01, 0xe3, 0xf0, 0x00,
+0x06, 0x3f, 0xf0, 0x00, 0x06, 0x0f, 0xe0, 0x00, 0x02, 0x01, 0xff, 0x7f,
+0x00, 0x00, 0x02, 0x01, 0x00, 0x06, 0x0f, 0xe0, 0x00, 0x06, 0x1f, 0xf0,
+0x00, 0x06, 0x1f, 0xf0, 0x00, 0x06, 0x1f, 0xf8, 0x00, 0x06, 0x3f, 0x87,
+0x00, 0x0e, 0x1f, 0x0f, 0x80, 0x00, 0x0e, 0x1f, 0x0f, 0x80, 0x00, 0x0e,
+0x1f, 0x0f, 0x80, 0x00, 0x0e, 0x0e, 0x1f, 0xc0, 0x00, 0x0e, 0x01, 0xff,
+0x80, 0x00, 0x0c, 0xff, 0x80, 0x00, 0x0c, 0xff, 0x80, 0x00, 0x04, 0x7f,
+0x00, 0x04, 0x08,
+};
@@ -0,0 +1,66 @@
+// Strip chart example, plots a triangle wave and reports CPU cycles per shift of the
+// chart and samples per second over Serial. For a wider display, adjust PIXELS_X.
+// Distributed under MIT License, see license.txt for details.
+
+#include <SPI.h>
+#include <SHARPMemLCDTxt.h>
+#include <SHARPMemLCDChart.h>
+
+SHARPMemLCDTxt display;       // configured for 43oh BoosterPack
+//SHARPMemLCDTxt display(6,5);  // configured for official TI BoosterPack
+
+#define CHART_HEIGHT 48
+
+SHARPMemLCDChart chart(display, 24, CHART_HEIGHT);
+
+unsigned char plane[PIXELS_X/8 * CHART_HEIGHT];
+
+unsigned char value = 0;
+char step = 1;
+
+unsigned char nextSample()
+{
+  value += step;
+  if (value == 0 || value == CHART_HEIGHT - 1) {
+    step = -step;
+  }
+  return value;
+}
+
+void setup()
+{
+  Serial.begin(9600);
+
+  display.begin(); // configure display
+
+  display.clear();
+  display.on();
+
+  display.print(" STRIPCHART ", 8, DISP_INVERT);
+
+  chart.begin(plane);
+}
+
+void loop()
+{
+  // measure shift alone
+  unsigned long start = micros();
+  for (int i = 0; i < 100; i++) {
+    chart.shift();
+  }
+  unsigned long time = micros() - start;
+
+  Serial.print(PIXELS_X);
+  Serial.print(" pixels, cycles/shift: ");
+  Serial.print(time * (F_CPU / 1000000) / 100);
+
+  // measure complete update with shift, plot and sending chart to display
+  start = millis();
+  for (int i = 0; i < 100; i++) {
+    chart.add(nextSample());
+  }
+  time = millis() - start;
+
+  Serial.print(", samples/s: ");
+  Serial.println(100000UL / (time ? time : 1));
+}
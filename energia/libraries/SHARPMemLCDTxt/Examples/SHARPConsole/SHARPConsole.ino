@@ -0,0 +1,43 @@
+// Scrolling console example, reports scrolling throughput over Serial.
+// Distributed under MIT License, see license.txt for details.
+
+#include <SPI.h>
+#include <SHARPMemLCDTxt.h>
+#include <SHARPMemLCDConsole.h>
+
+SHARPMemLCDTxt display;       // configured for 43oh BoosterPack
+//SHARPMemLCDTxt display(6,5);  // configured for official TI BoosterPack
+
+SHARPMemLCDConsole console(display, 8, 11);   // console below title line
+
+unsigned int count = 0;
+
+void setup()
+{
+  Serial.begin(9600);
+
+  display.begin(); // configure display
+
+  display.clear();
+  display.on();
+
+  display.print("  CONSOLE   ", 0, DISP_INVERT);
+}
+
+void loop()
+{
+  // print 100 lines, each one scrolls the console
+  unsigned long start = millis();
+
+  for (int i = 0; i < 100; i++) {
+    console.print("LINE ");
+    console.println(count++);
+  }
+
+  unsigned long time = millis() - start;
+
+  Serial.print("lines/s: ");
+  Serial.println(100000UL / time);
+
+  delay(2000);
+}
@@ -0,0 +1,234 @@
+// Display coprocessor, receives drawing commands over Serial from a host MCU or PC.
+// A client for PCs can be found in tools/sharpcoproc.py.
+// Distributed under MIT License, see license.txt for details.
+//
+// Protocol
+//   frame    0xA5 seq length commands... checksum
+//            length is number of bytes of commands, at most FRAME_MAX
+//            checksum is sum of seq, length and commands, modulo 256
+//   reply    0x06 seq when all commands of frame were executed
+//            0x15 seq error if frame was rejected, error is 1 for bad checksum, 2 for bad
+//                           length, 3 for invalid command (commands in front of it were executed)
+//   The host sends the next frame after receiving the reply to the previous one, so the
+//   UART is idle while commands are executed and the small receive buffer can't overflow.
+//
+// Commands, several commands can be batched into one frame
+//   0x01                                   clear display
+//   0x02 line options length text...       print text
+//   0x03 line count pattern                fill lines with pattern
+//   0x04 x y                               set scale
+//   0x05 line bytes rows data...           draw bitmap, rows of bytes*8 pixels, PackBits compressed,
+//                                          invalid if data ends before the last row is complete
+//   0x06 invert                            invert all following text and bitmaps if 1
+//   0x07 rotation                          set rotation
+//   0x08                                   flush, sends frame buffer if attached
+//   0x09 on                                turn display on (1) or off (0)
+
+#include <SPI.h>
+#include <SHARPMemLCDTxt.h>
+
+SHARPMemLCDTxt display;       // configured for 43oh BoosterPack
+//SHARPMemLCDTxt display(6,5);  // configured for official TI BoosterPack
+
+#define FRAME_SYNC 0xA5
+#define FRAME_MAX  64
+#define REPLY_ACK  0x06
+#define REPLY_NAK  0x15
+
+#define ERR_CHECKSUM 1
+#define ERR_LENGTH   2
+#define ERR_COMMAND  3
+
+#define CMD_CLEAR    0x01
+#define CMD_TEXT     0x02
+#define CMD_FILL     0x03
+#define CMD_SCALE    0x04
+#define CMD_BITMAP   0x05
+#define CMD_INVERT   0x06
+#define CMD_ROTATE   0x07
+#define CMD_FLUSH    0x08
+#define CMD_POWER    0x09
+
+unsigned char frame[FRAME_MAX];
+unsigned char state = 0;              // 0 sync, 1 seq, 2 length, 3 commands, 4 checksum
+unsigned char seq, length, pos, sum;
+char invert = 0;
+char scaleY = 1;                      // lines per bitmap row
+
+void receive(unsigned char b);
+char execute();
+
+void setup()
+{
+  Serial.begin(9600);
+
+  display.begin(); // configure display
+
+  display.clear();
+  display.on();
+}
+
+void loop()
+{
+  while (Serial.available()) {
+    receive(Serial.read());
+  }
+
+  display.pulse(0);
+}
+
+void reply(unsigned char code, unsigned char error)
+{
+  Serial.write(code);
+  Serial.write(seq);
+  if (code == REPLY_NAK) {
+    Serial.write(error);
+  }
+}
+
+// parse frame byte by byte
+void receive(unsigned char b)
+{
+  switch (state) {
+  case 0:
+    if (b == FRAME_SYNC) {
+      state = 1;
+    }
+    break;
+  case 1:
+    seq = b;
+    sum = b;
+    state = 2;
+    break;
+  case 2:
+    length = b;
+    sum += b;
+    pos = 0;
+    if (length > FRAME_MAX) {
+      reply(REPLY_NAK, ERR_LENGTH);
+      state = 0;
+    } else {
+      state = length ? 3 : 4;
+    }
+    break;
+  case 3:
+    frame[pos++] = b;
+    sum += b;
+    if (pos == length) {
+      state = 4;
+    }
+    break;
+  case 4:
+    state = 0;
+    if (b != sum) {
+      reply(REPLY_NAK, ERR_CHECKSUM);
+    } else if (execute()) {
+      reply(REPLY_ACK, 0);
+    } else {
+      reply(REPLY_NAK, ERR_COMMAND);
+    }
+    break;
+  }
+}
+
+// decode one row of PackBits data into row, advances p behind data
+// returns bytes decoded, less than bytes if data ended before row is complete
+unsigned char unpack(const unsigned char*& p, const unsigned char* end, unsigned char* row, unsigned char bytes)
+{
+  unsigned char n = 0;
+
+  while (n < bytes && p < end) {
+    signed char c = *p++;
+    if (c >= 0) {                     // c+1 literal bytes
+      unsigned char k = c + 1;
+      while (k-- && n < bytes && p < end) {
+        row[n++] = *p++;
+      }
+    } else if (c != -128 && p < end) { // byte repeated 1-c times
+      unsigned char k = 1 - c;
+      while (k-- && n < bytes) {
+        row[n++] = *p;
+      }
+      p++;
+    }
+  }
+
+  return n;
+}
+
+// execute all commands of frame, returns 0 if a command is invalid
+char execute()
+{
+  const unsigned char* p = frame;
+  const unsigned char* end = frame + length;
+  unsigned char row[PIXELS_X/8];
+  char text[PIXELS_X/8 + 1];
+
+  while (p < end) {
+    unsigned char cmd = *p++;
+    unsigned char left = end - p;
+
+    switch (cmd) {
+    case CMD_CLEAR:
+      display.clear();
+      break;
+    case CMD_TEXT:
+      if (left < 3 || left < 3 + p[2] || p[2] > PIXELS_X/8) return 0;
+      memcpy(text, p + 3, p[2]);
+      text[p[2]] = 0;
+      display.print(text, p[0], p[1] ^ invert);
+      p += 3 + p[2];
+      break;
+    case CMD_FILL:
+      if (left < 3) return 0;
+      display.fill(p[0], p[1], invert ? ~p[2] : p[2]);
+      p += 3;
+      break;
+    case CMD_SCALE:
+      if (left < 2) return 0;
+      display.setScale(p[0], p[1]);
+      scaleY = p[1] < 1 ? 1 : p[1];
+      p += 2;
+      break;
+    case CMD_BITMAP: {
+      if (left < 3 || p[1] > PIXELS_X/8) return 0;
+      int line = p[0];
+      unsigned char bytes = p[1];
+      unsigned char rows = p[2];
+      p += 3;
+      while (rows--) {                // rows are drawn as they are decompressed
+        if (unpack(p, end, row, bytes) < bytes) return 0;
+        display.bitmap(row, bytes * 8, 1, line, invert);
+        line += scaleY;
+      }
+      break;
+    }
+    case CMD_INVERT:
+      if (left < 1) return 0;
+      invert = p[0] ? DISP_INVERT : 0;
+      p += 1;
+      break;
+    case CMD_ROTATE:
+      if (left < 1) return 0;
+      if (!display.setRotation(p[0])) return 0;
+      p += 1;
+      break;
+    case CMD_FLUSH:
+      display.flush();
+      break;
+    case CMD_POWER:
+      if (left < 1) return 0;
+      if (p[0]) {
+        display.on();
+      } else {
+        display.off();
+      }
+      p += 1;
+      break;
+    default:
+      return 0;
+    }
+  }
+
+  return 1;
+}
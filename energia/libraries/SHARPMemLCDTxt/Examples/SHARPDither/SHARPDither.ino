@@ -0,0 +1,50 @@
+// Dithering example, draws a horizontal gray gradient with each dithering method.
+// Distributed under MIT License, see license.txt for details.
+
+#include <SPI.h>
+#include <SHARPMemLCDTxt.h>
+#include <SHARPMemLCDDither.h>
+
+SHARPMemLCDTxt display;       // configured for 43oh BoosterPack
+//SHARPMemLCDTxt display(6,5);  // configured for official TI BoosterPack
+
+SHARPMemLCDDither bayer(DITHER_BAYER);
+SHARPMemLCDDither floyd(DITHER_FLOYD);
+SHARPMemLCDDither atkinson(DITHER_ATKINSON);
+
+unsigned char gray[PIXELS_X];
+
+void drawGradient(SHARPMemLCDDither& dither, int line, int height)
+{
+  dither.begin(PIXELS_X);
+
+  while (height-- > 0) {
+    dither.draw(display, gray, line++);
+  }
+}
+
+void setup()
+{
+  display.begin(); // configure display
+
+  display.clear();
+  display.on();
+
+  // one row of gradient from black to white, rows are streamed one by one
+  for (int x = 0; x < PIXELS_X; x++) {
+    gray[x] = x * 255 / (PIXELS_X - 1);
+  }
+
+  display.print("   BAYER    ", 0);
+  drawGradient(bayer, 8, 24);
+  display.print("   FLOYD    ", 32);
+  drawGradient(floyd, 40, 24);
+  display.print("  ATKINSON  ", 64);
+  drawGradient(atkinson, 72, 24);
+}
+
+void loop()
+{
+  display.pulse(1);
+  delay(1000);
+}
@@ -0,0 +1,67 @@
+// Grayscale example, shows 4 levels of gray by temporal dithering and reports
+// achievable frame rate for several SPI clock settings over Serial.
+// Needs 3456 bytes of RAM for image and shadow buffer, e.g. MSP430F5529 or Tiva.
+// Distributed under MIT License, see license.txt for details.
+
+#include <SPI.h>
+#include <SHARPMemLCDTxt.h>
+#include <SHARPMemLCDGray.h>
+
+SHARPMemLCDTxt display;       // configured for 43oh BoosterPack
+//SHARPMemLCDTxt display(6,5);  // configured for official TI BoosterPack
+
+SHARPMemLCDGray gray(display, GRAY_2BPP);
+
+unsigned char image[PIXELS_X*PIXELS_Y*2/8];   // 2 bits per pixel
+unsigned char shadow[PIXELS_X*PIXELS_Y/8];    // last subframe sent to display
+
+// up to 1 MHz as specified by display, faster clocks are out of spec
+const unsigned long clocks[] = { 250000, 500000, 1000000 };
+
+void setup()
+{
+  Serial.begin(9600);
+
+  display.begin(); // configure display
+
+  display.clear();
+  display.on();
+
+  // four vertical bars from black to white, with white frame around them
+  for (int y = 0; y < PIXELS_Y; y++) {
+    for (int x = 0; x < PIXELS_X; x++) {
+      unsigned char level = x * 4 / PIXELS_X;
+      if (y < 8 || y >= PIXELS_Y - 8) {
+        level = 3;
+      }
+      int bit = (y * PIXELS_X + x) * 2;
+      image[bit / 8] |= level << (6 - bit % 8);
+    }
+  }
+
+  gray.begin(image, shadow);
+}
+
+void loop()
+{
+  for (int c = 0; c < 3; c++) {
+    SPI.setClockDivider(F_CPU / clocks[c]);
+
+    // cycle subframes as fast as possible for 2 seconds
+    unsigned long start = millis();
+    unsigned int frames = 0;
+    while (millis() - start < 2000) {
+      gray.tick();
+      frames++;
+    }
+
+    Serial.print("SCLK ");
+    Serial.print(clocks[c] / 1000);
+    Serial.print(" kHz: ");
+    Serial.print(frames / 2);
+    Serial.print(" subframes/s, ");
+    Serial.print(frames / 6);
+    Serial.println(" frames/s");
+  }
+
+}
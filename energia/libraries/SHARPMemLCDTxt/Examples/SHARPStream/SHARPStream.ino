@@ -0,0 +1,42 @@
+// Streaming example, shows PBM (P4) images received over Serial without holding them in memory.
+// Each line is sent to the display as soon as its last byte arrived. Send images e.g. with
+// stty -F /dev/ttyACM0 9600 raw && cat image.pbm > /dev/ttyACM0
+// Distributed under MIT License, see license.txt for details.
+
+#include <SPI.h>
+#include <SHARPMemLCDTxt.h>
+#include <SHARPMemLCDSink.h>
+
+SHARPMemLCDTxt display;       // configured for 43oh BoosterPack
+//SHARPMemLCDTxt display(6,5);  // configured for official TI BoosterPack
+
+SHARPMemLCDSink sink(display);
+
+void setup()
+{
+  Serial.begin(9600);
+
+  display.begin(); // configure display
+
+  display.clear();
+  display.on();
+
+  display.print("SEND PBM", 44);
+
+  sink.begin(SINK_PBM);
+}
+
+void loop()
+{
+  while (Serial.available()) {
+    sink.write(Serial.read());
+  }
+
+  int done = sink.done();
+  if (done) {
+    Serial.println(done > 0 ? "OK" : "INVALID");
+    sink.begin(SINK_PBM);     // wait for next image
+  }
+
+  display.pulse(0);
+}
@@ -3,12 +3,15 @@
 
 #include <SPI.h>
 #include <SHARPMemLCDTxt.h>
+#include <SHARPMemLCDNumber.h>
 #include "tilogo.h"
 
 SHARPMemLCDTxt display;       // configured for 43oh BoosterPack
 //SHARPMemLCDTxt display(6,5);  // configured for official TI BoosterPack
 
-char text_buffer[8];
+// pseudo clock, minutes count from 00 to 98, seconds from 00 to 59
+SHARPMemLCDNumber clock_display(display, " 98:59", 32, DISP_HIGH + DISP_WIDE);
+unsigned long next_second;
 
 void setup()
 {
@@ -21,17 +24,24 @@ void setup()
   display.clear();
   display.on();
 
-  // display TI logo for 2 seconds
+  // display TI logo for 2 seconds, toggling VCOM meanwhile
   display.bitmap(pixel_ti_logo, 96, 96, 0);
-  delay(2000);
+  unsigned long shown = millis();
+  while (millis() - shown < 2000) {
+    display.pulse(0); // toggles VCOM if last toggle was 500ms ago
+    delay(100);
+  }
   display.clear();
 
   // write static text  
   display.print("HELLO WORLD!", 8);
-  display.print("            ", 64, DISP_INVERT);
+  display.fill(64, 8, 0xff);
   display.print(" SHARP ", 72, DISP_INVERT + DISP_WIDE);
   display.print(" MEMORY LCD ", 80, DISP_INVERT);
-  display.print("            ", 88, DISP_INVERT);
+  display.fill(88, 8, 0xff);
+
+  clock_display.update();
+  next_second = millis() + 1000;
 }
 
 void loop()
@@ -39,19 +49,12 @@ void loop()
   // wait a while
   delay(500);
   
-  // update pseudo clock
-  long time = millis() / 1000;
-  
-  int time_minute = time / 60 % 99;
-  int time_second = time % 60;
- 
-  text_buffer[0] = ' ';
-  text_buffer[1] = time_minute / 10 + '0';
-  text_buffer[2] = time_minute % 10 + '0';
-  text_buffer[3] = ':';
-  text_buffer[4] = time_second / 10 + '0';
-  text_buffer[5] = time_second % 10 + '0';
-  text_buffer[6] = 0;
-
-  display.print(text_buffer, 32, DISP_HIGH + DISP_WIDE);
+  // update pseudo clock, counting each second that passed
+  while ((long)(millis() - next_second) >= 0) {
+    next_second += 1000;
+    clock_display.increment();
+  }
+
+  // only pixel lines that differ from the previous time are sent
+  clock_display.update();
 }
@@ -0,0 +1,120 @@
+// Player for delta encoded animations on SHARP Memory LCD.
+// Distributed under MIT License, see license.txt for details.
+
+#include <Arduino.h>
+#include <string.h>
+#include "SHARPMemLCDAnim.h"
+
+SHARPMemLCDAnim::SHARPMemLCDAnim(SHARPMemLCDTxt& display)
+    : m_display(display), m_data(0), m_next(0), m_shadow(0), m_line(0),
+      m_height(0), m_frames(0), m_frame(0), m_period(0), m_millis(0)
+{
+}
+
+// start animation, shadow must hold PIXELS_X/8 * height bytes
+// returns 0 if data is not an animation for this display
+char SHARPMemLCDAnim::begin(const unsigned char* data, unsigned char* shadow, int line)
+{
+    m_data = 0;
+
+    if (!data || !shadow) return 0;
+    if (data[0] != 'S' || data[1] != 'A' || data[2] != PIXELS_X/8) return 0;
+
+    m_data = data;
+    m_shadow = shadow;
+    m_line = line;
+    m_height = data[3];
+    m_frames = data[4] | (data[5] << 8);
+    m_period = data[6] | (data[7] << 8);
+
+    rewind();
+    return 1;
+}
+
+void SHARPMemLCDAnim::rewind()
+{
+    if (!m_data) return;
+
+    m_next = m_data + 8;
+    m_frame = 0;
+    m_millis = millis() - m_period;             // first frame is due immediately
+    memset(m_shadow, 0xff, (PIXELS_X/8) * m_height);
+}
+
+// decode next frame and send changed lines in one transaction
+// returns number of lines sent, or -1 if there are no more frames
+int SHARPMemLCDAnim::frame()
+{
+    if (!m_data || m_frame >= m_frames) return -1;
+
+    const unsigned char* p = m_next;
+    const unsigned char* lines = p;             // bitmap of changed lines
+    p += (m_height + 7) / 8;
+
+    m_display.pulse(0);
+
+    char* buffer = m_display.m_buffer;
+    unsigned char* s = m_shadow;
+    int sent = 0;
+    unsigned char y = 0;
+
+    while (y < m_height) {
+        if (lines[y >> 3] & (1 << (y & 7))) {   // line changed
+            const unsigned char* bytes = p;     // bitmap of changed bytes
+            p += (PIXELS_X/8 + 7) / 8;
+
+            unsigned char j = 0;
+            while (j < PIXELS_X/8) {            // apply delta to previous frame, straight into line buffer
+                unsigned char b = s[j];
+                if (bytes[j >> 3] & (1 << (j & 7))) {
+                    b ^= *p++;
+                    s[j] = b;
+                }
+                buffer[j] = b;
+                j++;
+            }
+
+            if (sent == 0) {                    // all changed lines are sent in one transaction
+                m_display.beginWrite();
+            }
+            if (m_line + y < PIXELS_Y) {
+                m_display.writeLine(m_line + y);
+            }
+            sent++;
+        }
+        s += PIXELS_X/8;
+        y++;
+    }
+
+    if (sent) {
+        m_display.endWrite();
+    }
+
+    m_next = p;
+    m_frame++;
+
+    return sent;
+}
+
+// show next frame once it is due, call this from loop
+// returns 0 once last frame was shown, unless loop is set
+char SHARPMemLCDAnim::play(char loop)
+{
+    if (!m_data) return 0;
+
+    if (m_frame >= m_frames) {
+        if (!loop) return 0;
+        rewind();
+    }
+
+    unsigned long time = millis();
+    if (time - m_millis >= m_period) {
+        m_millis += m_period;
+        if (time - m_millis >= m_period) {      // we're late, don't try to catch up
+            m_millis = time;
+        }
+        frame();
+    }
+
+    return 1;
+}
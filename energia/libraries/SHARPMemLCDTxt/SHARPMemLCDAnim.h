@@ -0,0 +1,38 @@
+// Player for delta encoded animations on SHARP Memory LCD.
+// Distributed under MIT License, see license.txt for details.
+
+#ifndef __SHARPMEMLCDANIM_H__
+#define __SHARPMEMLCDANIM_H__
+
+#include "SHARPMemLCDTxt.h"
+
+// Animation format, as created by tools/sharpanim.py
+//   header   'S' 'A' bytes-per-line height frames(16 bit) period-in-ms(16 bit), 16 bit values little endian
+//   frame    (height+7)/8 bytes, bit n (LSB first) set if line n changed
+//            for each changed line: (bytes-per-line+7)/8 bytes, bit n (LSB first) set if byte n of line changed
+//                                   followed by changed bytes, XORed with previous frame
+// The first frame is encoded against a white screen, with all lines marked as changed.
+
+class SHARPMemLCDAnim
+{
+private:
+    SHARPMemLCDTxt& m_display;
+    const unsigned char* m_data;
+    const unsigned char* m_next;
+    unsigned char* m_shadow;
+    int m_line;
+    unsigned char m_height;
+    unsigned int m_frames;
+    unsigned int m_frame;
+    unsigned int m_period;
+    unsigned long m_millis;
+
+public:
+    SHARPMemLCDAnim(SHARPMemLCDTxt& display);
+    char begin(const unsigned char* data, unsigned char* shadow, int line = 0);
+    void rewind();
+    int frame();
+    char play(char loop = 0);
+};
+
+#endif
@@ -0,0 +1,106 @@
+// Scrolling strip chart for SHARP Memory LCD.
+// Distributed under MIT License, see license.txt for details.
+
+#include <Arduino.h>
+#include <string.h>
+#include "SHARPMemLCDChart.h"
+
+SHARPMemLCDChart::SHARPMemLCDChart(SHARPMemLCDTxt& display, int line, int height)
+    : m_display(display), m_plane(0), m_line(line), m_height(height), m_last(0xff)
+{
+}
+
+// plane must hold PIXELS_X/8 * height bytes, in display format (set bits are white)
+void SHARPMemLCDChart::begin(unsigned char* plane)
+{
+    m_plane = plane;
+    clear();
+}
+
+void SHARPMemLCDChart::clear()
+{
+    if (!m_plane) return;
+
+    memset(m_plane, 0xff, (PIXELS_X/8) * m_height);
+    m_last = 0xff;
+}
+
+// shift chart left by one pixel, new column on the right is white
+void SHARPMemLCDChart::shift()
+{
+    if (!m_plane) return;
+
+    unsigned char* p = m_plane;
+    int y = m_height;
+
+    while (y--) {
+        unsigned char* end = p + PIXELS_X/8 - 1;
+        unsigned char b = *p;
+        while (p != end) {                      // shift each byte, carry in leftmost pixel of next byte
+            unsigned char n = p[1];
+            *p++ = (b << 1) | (n >> 7);
+            b = n;
+        }
+        *p++ = (b << 1) | 1;
+    }
+}
+
+// plot value in rightmost column, 0 is bottom of chart
+// a vertical line connects the value to the previous one
+void SHARPMemLCDChart::plot(unsigned char value)
+{
+    if (!m_plane) return;
+
+    if (value >= m_height) {
+        value = m_height - 1;
+    }
+
+    unsigned char top = value;
+    unsigned char bottom = value;
+    if (m_last != 0xff) {                       // extend to previous value
+        if (m_last > top) top = m_last;
+        if (m_last < bottom) bottom = m_last;
+    }
+    m_last = value;
+
+    unsigned char* p = m_plane + (m_height - 1 - top) * (PIXELS_X/8) + PIXELS_X/8 - 1;
+    unsigned char n = top - bottom + 1;
+    while (n--) {                               // pixels are LOW active
+        *p &= 0xfe;
+        p += PIXELS_X/8;
+    }
+}
+
+void SHARPMemLCDChart::add(unsigned char value, char update)
+{
+    shift();
+    plot(value);
+
+    if (update) {
+        flush();
+    }
+}
+
+// send lines of chart within display in one transaction, nothing if none is
+void SHARPMemLCDChart::flush()
+{
+    if (!m_plane) return;
+
+    m_display.pulse(0);
+
+    int y = m_line < 0 ? -m_line : 0;          // first and end row of plane on display
+    int end = PIXELS_Y - m_line < m_height ? PIXELS_Y - m_line : m_height;
+    if (y >= end) return;
+
+    m_display.beginWrite();
+
+    const unsigned char* p = m_plane + y*(PIXELS_X/8);
+    while (y < end) {
+        memcpy(m_display.m_buffer, p, PIXELS_X/8);
+        m_display.writeLine(m_line + y);
+        p += PIXELS_X/8;
+        y++;
+    }
+
+    m_display.endWrite();
+}
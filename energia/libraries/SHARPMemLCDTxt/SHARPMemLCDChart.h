@@ -0,0 +1,28 @@
+// Scrolling strip chart for SHARP Memory LCD.
+// Distributed under MIT License, see license.txt for details.
+
+#ifndef __SHARPMEMLCDCHART_H__
+#define __SHARPMEMLCDCHART_H__
+
+#include "SHARPMemLCDTxt.h"
+
+class SHARPMemLCDChart
+{
+private:
+    SHARPMemLCDTxt& m_display;
+    unsigned char* m_plane;
+    int m_line;
+    int m_height;
+    unsigned char m_last;
+
+public:
+    SHARPMemLCDChart(SHARPMemLCDTxt& display, int line, int height);
+    void begin(unsigned char* plane);
+    void clear();
+    void shift();
+    void plot(unsigned char value);
+    void add(unsigned char value, char update = 1);
+    void flush();
+};
+
+#endif
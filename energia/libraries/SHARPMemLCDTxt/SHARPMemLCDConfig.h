@@ -0,0 +1,59 @@
+// Compile time configuration of SHARPMemLCDTxt, edit this file or define options when building.
+// Distributed under MIT License, see license.txt for details.
+//
+// Unused methods and classes are removed by the linker. The options below also remove
+// features from methods that are always used, like print, to save flash on small parts.
+
+#ifndef __SHARPMEMLCDCONFIG_H__
+#define __SHARPMEMLCDCONFIG_H__
+
+// display size in pixels
+#ifndef PIXELS_X
+#define PIXELS_X 96
+#endif
+
+#ifndef PIXELS_Y
+#define PIXELS_Y 96
+#endif
+
+// range of characters in font, at most ' ' to 'Z'. characters outside are shown blank
+// e.g. '0' and ':' for clock digits only saves about 380 bytes of font data
+// or only the characters a sketch uses, with a header generated by tools/sharpfont.py from its strings
+//#include "fontset.h"
+#ifndef SHARP_FONT_FIRST
+#define SHARP_FONT_FIRST ' '
+#endif
+
+#ifndef SHARP_FONT_LAST
+#define SHARP_FONT_LAST 'Z'
+#endif
+
+// set to 1 to render text from tables derived from the font by the compiler, one for each combination
+// of DISP_INVERT and DISP_BOLD and double width, instead of transforming each row of a glyph when printing.
+// uses about 5 KB more flash with the full font on MSP430, less with a smaller range of characters
+#ifndef SHARP_FONT_TABLES
+#define SHARP_FONT_TABLES 0
+#endif
+
+// set to 0 to remove scaling with setScale, DISP_WIDE and DISP_HIGH
+#ifndef SHARP_SCALE
+#define SHARP_SCALE 1
+#endif
+
+// set to 0 to remove rotation and mirroring with setRotation
+#ifndef SHARP_ROTATION
+#define SHARP_ROTATION 1
+#endif
+
+// set to 0 to remove cache of rendered text lines set with setCache
+#ifndef SHARP_CACHE
+#define SHARP_CACHE 1
+#endif
+
+// uncomment to record what is sent to the display in a ring buffer of this many records, see traceDump
+//#define SHARP_TRACE 16
+
+// uncomment to record pixels of each line instead of a hash, needed to reconstruct frames from a trace
+//#define SHARP_TRACE_DATA
+
+#endif
@@ -0,0 +1,122 @@
+// Scrolling text console for SHARP Memory LCD.
+// Distributed under MIT License, see license.txt for details.
+
+#include <Arduino.h>
+#include <string.h>
+#include "SHARPMemLCDConsole.h"
+
+SHARPMemLCDConsole::SHARPMemLCDConsole(SHARPMemLCDTxt& display, int line, unsigned char rows, char options)
+    : m_display(display), m_line(line), m_rows(rows), m_options(options)
+{
+    if (m_rows > CONSOLE_ROWS) {
+        m_rows = CONSOLE_ROWS;
+    }
+    if (m_rows < 1) {                           // ring buffer needs a row
+        m_rows = 1;
+    }
+
+    memset(m_text, ' ', sizeof(m_text));
+    m_top = 0;
+    m_row = 0;
+    m_col = 0;
+    m_dirtyFirst = 0xff;
+    m_dirtyLast = 0;
+}
+
+void SHARPMemLCDConsole::clear()
+{
+    memset(m_text, ' ', sizeof(m_text));
+    m_top = 0;
+    m_row = 0;
+    m_col = 0;
+    setDirty(0, m_rows-1);
+    update();
+}
+
+size_t SHARPMemLCDConsole::write(uint8_t c)
+{
+    put(c);
+    update();
+    return 1;
+}
+
+size_t SHARPMemLCDConsole::write(const uint8_t* buffer, size_t size)
+{
+    size_t n = size;
+
+    while (n--) {                               // process all characters before drawing
+        put(*buffer++);
+    }
+
+    update();
+    return size;
+}
+
+void SHARPMemLCDConsole::update()
+{
+    if (m_dirtyFirst > m_dirtyLast) return;     // nothing to draw
+
+    m_display.pulse(0);
+    m_display.beginWrite();                     // all dirty rows are sent in one transaction
+
+    unsigned char r = m_dirtyFirst;
+    while (r <= m_dirtyLast) {                  // render rows directly from ring buffer
+        unsigned char t = m_top + r;
+        if (t >= m_rows) {
+            t -= m_rows;
+        }
+        m_display.renderText(m_text[t], CONSOLE_COLS, m_line + r*8, m_options, 1, 1);   // always unscaled
+        r++;
+    }
+
+    m_display.endWrite();
+
+    m_dirtyFirst = 0xff;
+    m_dirtyLast = 0;
+}
+
+void SHARPMemLCDConsole::put(char c)
+{
+    if (c == '\n') {                            // new line
+        newLine();
+    } else if (c == '\r') {                     // carriage return
+        m_col = 0;
+    } else {
+        if (m_col >= CONSOLE_COLS) {            // wrap long lines
+            newLine();
+        }
+        unsigned char t = m_top + m_row;
+        if (t >= m_rows) {
+            t -= m_rows;
+        }
+        m_text[t][m_col++] = c;
+        setDirty(m_row, m_row);
+    }
+}
+
+void SHARPMemLCDConsole::newLine()
+{
+    m_col = 0;
+
+    if (m_row + 1 < m_rows) {                   // move cursor down
+        m_row++;
+        return;
+    }
+
+    memset(m_text[m_top], ' ', CONSOLE_COLS);   // scroll by reusing top row as new bottom row
+    m_top++;
+    if (m_top >= m_rows) {
+        m_top = 0;
+    }
+    setDirty(0, m_rows-1);
+}
+
+void SHARPMemLCDConsole::setDirty(unsigned char first, unsigned char last)
+{
+    if (first < m_dirtyFirst) {
+        m_dirtyFirst = first;
+    }
+    if (last > m_dirtyLast) {
+        m_dirtyLast = last;
+    }
+}
@@ -0,0 +1,43 @@
+// Scrolling text console for SHARP Memory LCD.
+// Distributed under MIT License, see license.txt for details.
+
+#ifndef __SHARPMEMLCDCONSOLE_H__
+#define __SHARPMEMLCDCONSOLE_H__
+
+#include <Print.h>
+#include "SHARPMemLCDTxt.h"
+
+#define CONSOLE_COLS (PIXELS_X/8)
+#define CONSOLE_ROWS (PIXELS_Y/8)
+
+class SHARPMemLCDConsole : public Print
+{
+private:
+    SHARPMemLCDTxt& m_display;
+    char m_text[CONSOLE_ROWS][CONSOLE_COLS];    // ring buffer of text rows
+    int m_line;
+    unsigned char m_rows;
+    char m_options;
+    unsigned char m_top;                        // index of top row in ring buffer
+    unsigned char m_row;                        // cursor position
+    unsigned char m_col;
+    unsigned char m_dirtyFirst;                 // range of rows to redraw
+    unsigned char m_dirtyLast;
+
+    void put(char c);
+    void newLine();
+    void setDirty(unsigned char first, unsigned char last);
+
+public:
+    SHARPMemLCDConsole(SHARPMemLCDTxt& display,
+                       int line = 0,
+                       unsigned char rows = CONSOLE_ROWS,
+                       char options = 0);
+    void clear();
+    void update();
+    virtual size_t write(uint8_t c);
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    using Print::write;
+};
+
+#endif
@@ -0,0 +1,284 @@
+// Dithering of grayscale images for SHARP Memory LCD.
+// Distributed under MIT License, see license.txt for details.
+
+#include <Arduino.h>
+#include <string.h>
+#include "SHARPMemLCDDither.h"
+
+// 4x4 Bayer matrix, thresholds for ordered dithering
+static const unsigned char bayer4[4][4] = {
+    {   8, 136,  40, 168 },
+    { 200,  72, 232, 104 },
+    {  56, 184,  24, 152 },
+    { 248, 120, 216,  88 }
+};
+
+SHARPMemLCDDither::SHARPMemLCDDither(char mode)
+    : m_mode(mode), m_width(PIXELS_X), m_row(0)
+{
+}
+
+void SHARPMemLCDDither::begin(int width)
+{
+    if (width > PIXELS_X) {                     // ignore pixels beyond display
+        width = PIXELS_X;
+    }
+
+    m_width = width;
+    m_row = 0;
+    memset(m_error, 0, sizeof(m_error));
+}
+
+void SHARPMemLCDDither::convert(const unsigned char* gray, unsigned char* out)
+{
+    convertRow(gray, out, 0xff);                // set bits are black, as used by bitmap()
+}
+
+void SHARPMemLCDDither::draw(SHARPMemLCDTxt& display, const unsigned char* gray, int line, char options)
+{
+    unsigned char* buffer = (unsigned char*)display.m_buffer;
+
+    memset(buffer, 0xff, PIXELS_X/8);           // pad line right of image
+
+    // pixels are LOW active, invert bits if DISP_INVERT is _NOT_ selected
+    convertRow(gray, buffer, (options & DISP_INVERT) ? 0xff : 0);
+
+    display.pulse(0);
+    display.writeBuffer(line);
+}
+
+// convert one row of 8 bit grayscale pixels (0 black, 255 white) to packed pixels
+// bits of white pixels are set, then all bits are XORed with mask
+void SHARPMemLCDDither::convertRow(const unsigned char* gray, unsigned char* out, unsigned char mask)
+{
+    // b = pixel byte
+    // x = pixel index
+    // v = pixel value with diffused error
+    // e = quantization error
+    unsigned char b = 0;
+    int x = 0;
+    int v, e;
+
+    if (m_mode == DITHER_BAYER) {
+        const unsigned char* t = bayer4[m_row & 3];
+        while (x < m_width) {
+            b <<= 1;
+            if (gray[x] >= t[x & 3]) {          // compare with threshold of matrix
+                b |= 1;
+            }
+            x++;
+            if ((x & 7) == 0) {
+                *out++ = b ^ mask;
+            }
+        }
+    } else if (m_mode == DITHER_FLOYD) {
+        // error of current row is read from buffer, and replaced by error of next row as we go
+        signed char* err = m_error[0];
+        int right = 0;                          // 7/16 of error for pixel to the right
+        int left = 0;                           // next row errors for pixel to the left, below and below right
+        int below = 0;
+
+        while (x < m_width) {
+            v = gray[x] + err[x+1] + right;
+            b <<= 1;
+            if (v >= 128) {
+                b |= 1;
+                e = v - 255;
+            } else {
+                e = v;
+            }
+            if (e > 127) e = 127;               // keep error within range of buffer
+            if (e < -127) e = -127;
+
+            right = (e * 7) >> 4;
+            err[x] = left + ((e * 3) >> 4);     // error below left is complete, store it
+            left = below + ((e * 5) >> 4);
+            below = e >> 4;
+
+            x++;
+            if ((x & 7) == 0) {
+                *out++ = b ^ mask;
+            }
+        }
+        err[x] = left;
+    } else {
+        // error of current row is read from one buffer and replaced by error two rows below
+        // error of next row is added to the other buffer
+        signed char* err = m_error[m_row & 1];
+        signed char* next = m_error[(m_row & 1) ^ 1];
+        int right1 = 0;                         // 1/8 of error for next two pixels to the right
+        int right2 = 0;
+
+        while (x < m_width) {
+            v = gray[x] + err[x+1] + right1;
+            b <<= 1;
+            if (v >= 128) {
+                b |= 1;
+                e = v - 255;
+            } else {
+                e = v;
+            }
+            if (e > 127) e = 127;
+            if (e < -127) e = -127;
+
+            e >>= 3;                            // Atkinson diffuses 6 times 1/8 of the error
+            right1 = right2 + e;
+            right2 = e;
+            next[x] += e;
+            next[x+1] += e;
+            next[x+2] += e;
+            err[x+1] = e;
+
+            x++;
+            if ((x & 7) == 0) {
+                *out++ = b ^ mask;
+            }
+        }
+        next[x+1] = 0;                          // drop error diffused beyond right edge
+    }
+
+    if (x & 7) {                                // store last partial byte, padded with white
+        b = (b << (8 - (x & 7))) | (0xff >> (x & 7));
+        *out = b ^ mask;
+    }
+
+    m_row++;
+}
+
+#ifdef __linux__
+// host only, dithers several rows at once with the same result as convert for each row
+// rows of a batch are 16 bit vector lanes. each step processes one pixel of every row, row l of the
+// batch runs 2 pixels behind row l-1, as its error from above is complete there. error arriving
+// at each row is kept skewed by step, so a step reads and adds whole vectors
+
+#define DITHER_LANES 8                          // lanes of vectors, the last two only collect error
+#define DITHER_BATCH 6                          // rows dithered per batch
+#define DITHER_STEPS (PIXELS_X + 2*DITHER_LANES + 4)
+
+typedef short Lanes __attribute__((vector_size(DITHER_LANES * sizeof(short))));
+typedef unsigned short Bits __attribute__((vector_size(DITHER_LANES * sizeof(short))));
+
+// lanes moved to the rows below, with zero error for the first rows
+static const Lanes belowOne = { 15, 0, 1, 2, 3, 4, 5, 6 };
+static const Lanes belowTwo = { 15, 15, 0, 1, 2, 3, 4, 5 };
+
+static void below(const Lanes& e, const Lanes& shift, Lanes& out)
+{
+#ifdef __clang__
+    for (int l = 0; l < DITHER_LANES; l++) {
+        out[l] = shift[l] < DITHER_LANES ? e[shift[l]] : 0;
+    }
+#else
+    const Lanes zero = { 0 };
+
+    out = __builtin_shuffle(e, zero, shift);
+#endif
+}
+
+void SHARPMemLCDDither::convertRows(const unsigned char* gray, int stride, unsigned char* out, int outStride, int rows)
+{
+    if (m_mode == DITHER_BAYER) {               // no error to carry, rows are independent
+        while (rows-- > 0) {
+            convertRow(gray, out, 0xff);
+            gray += stride;
+            out += outStride;
+        }
+        return;
+    }
+
+    Lanes incoming[DITHER_STEPS];               // error from above, by step and row
+    Lanes pixels[DITHER_STEPS];                 // gray by step and row, -1 where row is outside image
+    const Lanes zero = { 0 };
+    const Lanes c127 = zero + 127;
+    const Lanes c255 = zero + 255;
+    int w = m_width;
+    int atkinson = m_mode == DITHER_ATKINSON;
+
+    while (rows > 0) {
+        int n = rows < DITHER_BATCH ? rows : DITHER_BATCH;
+        int steps = w + 2*(n - 1);
+        signed char* err = m_error[atkinson ? m_row & 1 : 0];
+        signed char* next = m_error[(m_row & 1) ^ 1];
+
+        memset(incoming, 0, (steps + 5) * sizeof(Lanes));
+        memset(pixels, 0xff, steps * sizeof(Lanes));
+        for (int x = 0; x < w; x++) {           // error of first row, and of second row from the row above
+            incoming[x][0] = err[x+1];
+            if (atkinson) {
+                incoming[x + 2][1] = next[x+1];
+            }
+        }
+        for (int l = 0; l < n; l++) {           // skew rows to steps
+            for (int x = 0; x < w; x++) {
+                pixels[x + 2*l][l] = gray[l*stride + x];
+            }
+        }
+
+        Lanes right1 = zero;                    // error for the pixel to the right, and the one after for Atkinson
+        Lanes right2 = zero;
+        Bits bits = { 0 };                      // last pixels of each row
+
+        for (int t = 0; t < steps; t++) {
+            Lanes g = pixels[t];
+            Lanes active = g >= 0;
+            Lanes v = g + incoming[t] + right1;
+            Lanes m = v >= 128;
+            Lanes e = v - (c255 & m);
+            bits = (bits << 1) | (Bits)(m & 1);
+            m = e > c127;                       // keep error within range of buffer
+            e = (e & ~m) | (c127 & m);
+            m = e < -c127;
+            e = (e & ~m) | (-c127 & m);
+            e &= active;
+
+            Lanes d;
+            if (atkinson) {
+                e >>= 3;                        // 1/8 to two pixels right, three below and one two rows below
+                right1 = right2 + e;
+                right2 = e;
+                below(e, belowOne, d);
+                incoming[t + 1] += d;
+                incoming[t + 2] += d;
+                incoming[t + 3] += d;
+                below(e, belowTwo, d);
+                incoming[t + 4] += d;
+            } else {
+                right1 = (e * 7) >> 4;          // 7/16 right, 3/16 below left, 5/16 below, 1/16 below right
+                below(e, belowOne, d);
+                incoming[t + 1] += (d * 3) >> 4;
+                incoming[t + 2] += (d * 5) >> 4;
+                incoming[t + 3] += d >> 4;
+            }
+
+            if (t & 1) {                        // rows that completed a byte at this step
+                for (int l = ((t - 7) >> 1) & 3; l < n; l += 4) {
+                    int x = t - 2*l;
+                    if (x >= 0 && x < w) {
+                        out[l*outStride + (x >> 3)] = bits[l] ^ 0xff;
+                    }
+                }
+            }
+            int l = t - (w - 1);
+            if ((w & 7) && l >= 0 && !(l & 1) && (l >>= 1) < n) {
+                // last partial byte, padded with white
+                unsigned char b = (bits[l] << (8 - (w & 7))) | (0xff >> (w & 7));
+                out[l*outStride + (w >> 3)] = b ^ 0xff;
+            }
+        }
+
+        m_row += n;                             // error of the rows after the batch, as convert leaves it
+        err = m_error[atkinson ? m_row & 1 : 0];
+        next = m_error[(m_row & 1) ^ 1];
+        for (int x = 0; x < w; x++) {
+            err[x+1] = incoming[x + 2*n][n];
+            if (atkinson) {
+                next[x+1] = incoming[x + 2*n + 2][n + 1];
+            }
+        }
+
+        gray += n*stride;
+        out += n*outStride;
+        rows -= n;
+    }
+}
+#endif
@@ -0,0 +1,33 @@
+// Dithering of grayscale images for SHARP Memory LCD.
+// Distributed under MIT License, see license.txt for details.
+
+#ifndef __SHARPMEMLCDDITHER_H__
+#define __SHARPMEMLCDDITHER_H__
+
+#include "SHARPMemLCDTxt.h"
+
+#define DITHER_BAYER 0
+#define DITHER_FLOYD 1
+#define DITHER_ATKINSON 2
+
+class SHARPMemLCDDither
+{
+private:
+    char m_mode;
+    int m_width;
+    unsigned char m_row;
+    signed char m_error[2][PIXELS_X+2];         // diffused error of next two rows, offset by one pixel
+
+    void convertRow(const unsigned char* gray, unsigned char* out, unsigned char mask);
+
+public:
+    SHARPMemLCDDither(char mode = DITHER_FLOYD);
+    void begin(int width);
+    void convert(const unsigned char* gray, unsigned char* out);
+    void draw(SHARPMemLCDTxt& display, const unsigned char* gray, int line, char options = 0);
+#ifdef __linux__
+    void convertRows(const unsigned char* gray, int stride, unsigned char* out, int outStride, int rows);
+#endif
+};
+
+#endif
@@ -0,0 +1,119 @@
+// Grayscale by temporal dithering for SHARP Memory LCD.
+// Distributed under MIT License, see license.txt for details.
+
+#include <Arduino.h>
+#include <string.h>
+#include "SHARPMemLCDGray.h"
+
+// phase of each pixel within a 4x4 block, spreads pixels of same level over all subframes
+static const unsigned char phase4[4][4] = {
+    {  0,  8,  2, 10 },
+    { 12,  4, 14,  6 },
+    {  3, 11,  1,  9 },
+    { 15,  7, 13,  5 }
+};
+
+SHARPMemLCDGray::SHARPMemLCDGray(SHARPMemLCDTxt& display, char bpp)
+    : m_display(display), m_image(0), m_shadow(0), m_subframe(0), m_full(1)
+{
+    m_bpp = (bpp == GRAY_4BPP) ? GRAY_4BPP : GRAY_2BPP;
+    m_levels = (1 << m_bpp) - 1;
+}
+
+void SHARPMemLCDGray::begin(const unsigned char* image, unsigned char* shadow)
+{
+    m_image = image;
+    m_shadow = shadow;
+    m_subframe = 0;
+    m_full = 1;                                 // first subframe is sent completely
+}
+
+// send next subframe, only lines that changed since last subframe are sent
+// returns number of lines sent
+int SHARPMemLCDGray::tick()
+{
+    if (!m_image) return 0;
+
+    m_display.pulse(0);
+
+    int line = 0;
+    int sent = 0;
+
+    while (line < PIXELS_Y) {
+        renderLine(line);
+
+        if (m_shadow) {                         // skip line if same as in last subframe
+            unsigned char* s = m_shadow + line*(PIXELS_X/8);
+            if (!m_full && memcmp(s, m_display.m_buffer, PIXELS_X/8) == 0) {
+                line++;
+                continue;
+            }
+            memcpy(s, m_display.m_buffer, PIXELS_X/8);
+        }
+
+        if (sent == 0) {                        // all changed lines are sent in one transaction
+            m_display.beginWrite();
+        }
+        m_display.writeLine(line);
+        sent++;
+        line++;
+    }
+
+    if (sent) {
+        m_display.endWrite();
+    }
+
+    m_full = 0;
+    m_subframe++;
+    if (m_subframe >= m_levels) {
+        m_subframe = 0;
+    }
+
+    return sent;
+}
+
+// render line of current subframe into line buffer of display
+// a pixel is white if its level is above the threshold, which cycles through all levels with each subframe
+void SHARPMemLCDGray::renderLine(int line)
+{
+    unsigned char t[4];
+    unsigned char i = 0;
+    while (i < 4) {                             // thresholds for pixels of this line
+        t[i] = (m_subframe + phase4[line & 3][i]) % m_levels;
+        i++;
+    }
+
+    const unsigned char* p = m_image + line*(PIXELS_X/8)*m_bpp;
+    unsigned char* buffer = (unsigned char*)m_display.m_buffer;
+    unsigned char j = 0;
+
+    if (m_bpp == GRAY_2BPP) {
+        while (j < PIXELS_X/8) {                // 8 pixels from 2 bytes of image
+            unsigned char b = 0;
+            unsigned char k = 0;
+            while (k < 2) {
+                unsigned char g = *p++;
+                b <<= 4;
+                if ((g >> 6) > t[0]) b |= 8;
+                if (((g >> 4) & 3) > t[1]) b |= 4;
+                if (((g >> 2) & 3) > t[2]) b |= 2;
+                if ((g & 3) > t[3]) b |= 1;
+                k++;
+            }
+            buffer[j++] = b;
+        }
+    } else {
+        while (j < PIXELS_X/8) {                // 8 pixels from 4 bytes of image
+            unsigned char b = 0;
+            unsigned char k = 0;
+            while (k < 4) {
+                unsigned char g = *p++;
+                b <<= 2;
+                if ((g >> 4) > t[(k & 1) << 1]) b |= 2;
+                if ((g & 15) > t[((k & 1) << 1) + 1]) b |= 1;
+                k++;
+            }
+            buffer[j++] = b;
+        }
+    }
+}
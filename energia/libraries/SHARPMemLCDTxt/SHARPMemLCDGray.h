@@ -0,0 +1,31 @@
+// Grayscale by temporal dithering for SHARP Memory LCD.
+// Distributed under MIT License, see license.txt for details.
+
+#ifndef __SHARPMEMLCDGRAY_H__
+#define __SHARPMEMLCDGRAY_H__
+
+#include "SHARPMemLCDTxt.h"
+
+#define GRAY_2BPP 2
+#define GRAY_4BPP 4
+
+class SHARPMemLCDGray
+{
+private:
+    SHARPMemLCDTxt& m_display;
+    const unsigned char* m_image;
+    unsigned char* m_shadow;
+    char m_bpp;
+    unsigned char m_levels;
+    unsigned char m_subframe;
+    char m_full;
+
+    void renderLine(int line);
+
+public:
+    SHARPMemLCDGray(SHARPMemLCDTxt& display, char bpp = GRAY_2BPP);
+    void begin(const unsigned char* image, unsigned char* shadow = 0);
+    int tick();
+};
+
+#endif
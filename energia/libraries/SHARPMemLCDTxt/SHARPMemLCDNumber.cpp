@@ -0,0 +1,151 @@
+// Numeric display with digit counting and partial updates for SHARP Memory LCD.
+// Distributed under MIT License, see license.txt for details.
+
+#include <Arduino.h>
+#include <string.h>
+#include "SHARPMemLCDNumber.h"
+
+// format is a template of the text to show, e.g. " 59:59"
+// consecutive characters '0' to '9' form a field, that counts up to the value it shows, e.g. 00 to 59
+// all other characters are shown as they are
+SHARPMemLCDNumber::SHARPMemLCDNumber(SHARPMemLCDTxt& display, const char* format, int line, char options)
+    : m_display(display), m_format(format), m_line(line), m_options(options), m_full(1)
+{
+    unsigned char i = 0;
+    while (i < PIXELS_X/8 && format[i] != 0) {  // all digits start at 0
+        char c = format[i];
+        m_text[i] = (c >= '0' && c <= '9') ? '0' : c;
+        i++;
+    }
+    m_text[i] = 0;
+    m_length = i;
+    memcpy(m_shown, m_text, i + 1);
+}
+
+// set digits from value, lowest digits are shown if value has more digits than format
+// digits are found by subtracting powers of 10, as MSP430 has no hardware division
+void SHARPMemLCDNumber::set(unsigned long value)
+{
+    char digits[10];
+    unsigned char d = 10;
+
+    SHARPMemLCDTxt::toDecimal(value, digits);
+
+    unsigned char i = m_length;
+    while (i-- > 0) {                           // fill digits from the right
+        char c = m_format[i];
+        if (c >= '0' && c <= '9') {
+            m_text[i] = (d > 0) ? digits[--d] : '0';
+        }
+    }
+}
+
+void SHARPMemLCDNumber::setDigit(unsigned char pos, unsigned char digit)
+{
+    if (pos < m_length && digit <= 9) {
+        m_text[pos] = '0' + digit;
+    }
+}
+
+// count up by one, fields roll over after reaching their value in format and carry to the field on their left
+void SHARPMemLCDNumber::increment()
+{
+    unsigned char end = m_length;
+
+    while (end > 0) {
+        char c = m_format[end - 1];
+        if (c < '0' || c > '9') {               // skip fixed characters
+            end--;
+            continue;
+        }
+
+        unsigned char start = end - 1;          // find first digit of field
+        while (start > 0 && m_format[start - 1] >= '0' && m_format[start - 1] <= '9') {
+            start--;
+        }
+
+        unsigned char i = end;
+        if (memcmp(m_text + start, m_format + start, end - start) < 0) {
+            while (m_text[--i] == '9') {        // field not at limit, count up with carry inside field
+                m_text[i] = '0';
+            }
+            m_text[i]++;
+            return;
+        }
+
+        while (i > start) {                     // roll over and carry to next field
+            m_text[--i] = '0';
+        }
+        end = start;
+    }
+}
+
+// send changed pixel lines to display
+// a line is only sent if a changed digit has different pixels in that line
+void SHARPMemLCDNumber::update()
+{
+    unsigned char changed[PIXELS_X/8];
+    unsigned char n = 0;
+    unsigned char i = 0;
+
+    while (i < m_length) {                      // find changed characters
+        if (m_full || m_text[i] != m_shown[i]) {
+            changed[n++] = i;
+        }
+        i++;
+    }
+
+    m_display.pulse(0);
+
+    if (n == 0) return;
+
+    unsigned char scaleY = m_display.m_scaleY;
+    if (SHARP_SCALE && (m_options & DISP_HIGH)) {
+        scaleY <<= 1;
+    }
+
+    int line = m_line;
+    char open = 0;
+    unsigned char k = 0;
+
+    while (k < 8 && line < PIXELS_Y) {
+        char send = m_full;
+        i = 0;
+        while (!send && i < n) {                // compare pixels of old and new characters
+            unsigned char c = changed[i++];
+            if (SHARPMemLCDTxt::glyphRow(m_text[c], k) != SHARPMemLCDTxt::glyphRow(m_shown[c], k)) {
+                send = 1;
+            }
+        }
+
+        if (send) {
+            if (!open) {                        // all lines are sent in one transaction
+                m_display.beginWrite();
+                open = 1;
+            }
+
+            m_display.renderRow(m_text, m_length, k, m_options, m_display.m_scaleX);
+
+            unsigned char h = scaleY;
+            int l = line;
+            do {                                // repeat line for vertical scale
+                m_display.writeLine(l++);
+            } while (--h && l < PIXELS_Y);
+        }
+
+        line += scaleY;
+        k++;
+    }
+
+    if (open) {
+        m_display.endWrite();
+    }
+
+    memcpy(m_shown, m_text, m_length);
+    m_full = 0;
+}
+
+const char* SHARPMemLCDNumber::text()
+{
+    return m_text;
+}
@@ -0,0 +1,30 @@
+// Numeric display with digit counting and partial updates for SHARP Memory LCD.
+// Distributed under MIT License, see license.txt for details.
+
+#ifndef __SHARPMEMLCDNUMBER_H__
+#define __SHARPMEMLCDNUMBER_H__
+
+#include "SHARPMemLCDTxt.h"
+
+class SHARPMemLCDNumber
+{
+private:
+    SHARPMemLCDTxt& m_display;
+    const char* m_format;
+    int m_line;
+    char m_options;
+    unsigned char m_length;
+    char m_full;
+    char m_text[PIXELS_X/8 + 1];                // current text
+    char m_shown[PIXELS_X/8 + 1];               // text on display
+
+public:
+    SHARPMemLCDNumber(SHARPMemLCDTxt& display, const char* format, int line, char options = 0);
+    void set(unsigned long value);
+    void setDigit(unsigned char pos, unsigned char digit);
+    void increment();
+    void update();
+    const char* text();
+};
+
+#endif
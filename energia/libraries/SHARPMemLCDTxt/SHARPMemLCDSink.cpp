@@ -0,0 +1,218 @@
+// Streaming image input for SHARP Memory LCD, lines are sent as soon as they are complete.
+// Distributed under MIT License, see license.txt for details.
+
+#include <Arduino.h>
+#include "SHARPMemLCDSink.h"
+
+#define STATE_HEADER 0
+#define STATE_DATA   1
+#define STATE_DONE   2
+#define STATE_ERROR  3
+
+#define FLAG_DIGITS  0x01                       // number in progress
+#define FLAG_SEP     0x02                       // previous character separates tokens
+#define FLAG_COMMENT 0x04                       // inside PBM comment
+
+SHARPMemLCDSink::SHARPMemLCDSink(SHARPMemLCDTxt& display)
+    : m_display(display), m_format(SINK_RAW), m_state(STATE_DONE), m_line(0), m_options(0),
+      m_width(0), m_rows(0), m_stride(0), m_col(0), m_value(0), m_field(0), m_flags(0)
+{
+}
+
+// prepare for a new image, width and height are only used by SINK_RAW,
+// PBM and XBM take them from their header
+void SHARPMemLCDSink::begin(char format, int line, char options, int width, int height)
+{
+    m_format = format;
+    m_line = line;
+    m_options = options;
+    m_width = width;
+    m_rows = height;
+    m_value = 0;
+    m_field = 0;
+    m_flags = FLAG_SEP;
+
+    if (format == SINK_RAW) {
+        start();
+    } else {
+        m_state = STATE_HEADER;
+    }
+}
+
+// returns 1 when all rows were received, -1 if data was invalid, 0 otherwise
+int SHARPMemLCDSink::done()
+{
+    if (m_state == STATE_ERROR) return -1;
+    return m_state == STATE_DONE;
+}
+
+void SHARPMemLCDSink::start()
+{
+    m_stride = (m_width + 7) / 8;
+    m_col = 0;
+    m_value = 0;
+    m_flags = 0;
+    m_state = (m_width > 0 && m_rows > 0) ? STATE_DATA : STATE_DONE;
+}
+
+// parse header of PBM or XBM
+void SHARPMemLCDSink::header(unsigned char c)
+{
+    if (m_format == SINK_PBM) {
+        if (m_flags & FLAG_COMMENT) {           // comments end with line
+            if (c == '\n') m_flags &= ~FLAG_COMMENT;
+            return;
+        }
+        if (m_field < 2) {                      // magic number P4
+            if (c != (m_field ? '4' : 'P')) {
+                m_state = STATE_ERROR;
+            }
+            m_field++;
+            return;
+        }
+        if (c >= '0' && c <= '9') {
+            m_value = m_value * 10 + (c - '0');
+            m_flags |= FLAG_DIGITS;
+            return;
+        }
+        if (c != '#' && c != ' ' && c != '\t' && c != '\r' && c != '\n') {
+            m_state = STATE_ERROR;
+            return;
+        }
+        if (c == '#') {
+            m_flags |= FLAG_COMMENT;
+        }
+        if (m_flags & FLAG_DIGITS) {            // end of width or height
+            if (m_field == 2) {
+                m_width = m_value;
+            } else {
+                m_rows = m_value;
+            }
+            m_value = 0;
+            m_flags &= ~FLAG_DIGITS;
+            if (++m_field == 4) {               // raster follows single whitespace after height
+                if (c == '#') {
+                    m_state = STATE_ERROR;
+                } else {
+                    start();
+                }
+            }
+        }
+        return;
+    }
+
+    // XBM, first two numbers in #define lines are width and height, raster starts after {
+    if (c == '{') {
+        if (m_field < 2) {
+            m_state = STATE_ERROR;
+        } else {
+            start();
+        }
+        return;
+    }
+    if (c >= '0' && c <= '9' && (m_flags & (FLAG_SEP | FLAG_DIGITS))) {
+        m_value = m_value * 10 + (c - '0');     // number, but not digits within names
+        m_flags |= FLAG_DIGITS;
+        m_flags &= ~FLAG_SEP;
+        return;
+    }
+    if (m_flags & FLAG_DIGITS) {
+        if (m_field == 0) {
+            m_width = m_value;
+        } else if (m_field == 1) {
+            m_rows = m_value;
+        }
+        m_field++;
+        m_value = 0;
+        m_flags &= ~FLAG_DIGITS;
+    }
+    if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_') {
+        m_flags &= ~FLAG_SEP;
+    } else {
+        m_flags |= FLAG_SEP;
+    }
+}
+
+// store byte of row in line buffer of display, inverting in flight
+// line is sent as soon as its last byte arrived
+void SHARPMemLCDSink::put(unsigned char b)
+{
+    if (m_format == SINK_XBM) {                 // XBM stores leftmost pixel in LSB
+        b = SHARPMemLCDTxt::bitrev[b];
+    }
+    if (!(m_options & DISP_INVERT)) {           // invert bits if DISP_INVERT is _NOT_ selected
+        b = ~b;                                 // pixels are LOW active
+    }
+    if (m_col == m_stride - 1 && (m_width & 7)) {
+        b |= 0xff >> (m_width & 7);             // padding bits of last byte are white
+    }
+    if (m_col < PIXELS_X/8) {                   // clip at right edge of display
+        m_display.m_buffer[m_col] = b;
+    }
+
+    if (++m_col < m_stride) return;
+
+    int j = m_stride;
+    while (j < PIXELS_X/8) {                    // pad line right of image
+        m_display.m_buffer[j++] = 0xff;
+    }
+    m_col = 0;
+
+    if (m_line >= 0 && m_line < PIXELS_Y) {     // rows above display are skipped
+        m_display.pulse(0);
+        m_display.writeBuffer(m_line);
+    }
+    if (m_line < PIXELS_Y) {                    // stop below display, so line can't wrap around
+        m_line++;
+    }
+    if (--m_rows == 0) {
+        m_state = STATE_DONE;
+    }
+}
+
+size_t SHARPMemLCDSink::write(uint8_t c)
+{
+    switch (m_state) {
+    case STATE_HEADER:
+        header(c);
+        return 1;
+    case STATE_DATA:
+        if (m_format != SINK_XBM) {
+            put(c);
+            return 1;
+        }
+        // XBM raster is text, hex numbers separated by commas
+        if (c == 'x' || c == 'X') {             // skip 0 of 0x prefix
+            m_value = 0;
+        } else if (c >= '0' && c <= '9') {
+            m_value = (m_value << 4) | (c - '0');
+            m_flags |= FLAG_DIGITS;
+        } else if ((c | 0x20) >= 'a' && (c | 0x20) <= 'f') {
+            m_value = (m_value << 4) | ((c | 0x20) - 'a' + 10);
+            m_flags |= FLAG_DIGITS;
+        } else {
+            if (m_flags & FLAG_DIGITS) {
+                put(m_value);
+                m_value = 0;
+                m_flags &= ~FLAG_DIGITS;
+            }
+            if (c == '}' && m_state == STATE_DATA) {
+                m_state = STATE_ERROR;          // raster ended before last row
+            }
+        }
+        return 1;
+    }
+
+    return 0;                                   // image complete, no more data accepted
+}
+
+size_t SHARPMemLCDSink::write(const uint8_t* buffer, size_t size)
+{
+    size_t n = 0;
+
+    while (n < size && write(buffer[n])) {
+        n++;
+    }
+
+    return n;
+}
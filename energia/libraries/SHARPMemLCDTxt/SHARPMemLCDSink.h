@@ -0,0 +1,43 @@
+// Streaming image input for SHARP Memory LCD, lines are sent as soon as they are complete.
+// Distributed under MIT License, see license.txt for details.
+
+#ifndef __SHARPMEMLCDSINK_H__
+#define __SHARPMEMLCDSINK_H__
+
+#include <Print.h>
+#include "SHARPMemLCDTxt.h"
+
+#define SINK_RAW 0                              // rows of (width+7)/8 bytes as for bitmap, size given to begin
+#define SINK_PBM 1                              // binary PBM (P4)
+#define SINK_XBM 2                              // X BitMap, C source text
+
+class SHARPMemLCDSink : public Print
+{
+private:
+    SHARPMemLCDTxt& m_display;
+    char m_format;
+    char m_state;
+    int m_line;
+    char m_options;
+    int m_width;
+    int m_rows;                                 // rows left to receive
+    int m_stride;
+    int m_col;                                  // byte position in current row
+    int m_value;                                // number being parsed
+    unsigned char m_field;                      // header field being parsed
+    unsigned char m_flags;
+
+    void header(unsigned char c);
+    void start();
+    void put(unsigned char b);
+
+public:
+    SHARPMemLCDSink(SHARPMemLCDTxt& display);
+    void begin(char format, int line = 0, char options = 0, int width = PIXELS_X, int height = PIXELS_Y);
+    int done();
+    virtual size_t write(uint8_t c);
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    using Print::write;
+};
+
+#endif
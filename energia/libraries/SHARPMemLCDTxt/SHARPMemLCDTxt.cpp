@@ -3,6 +3,8 @@
 
 #include <Arduino.h>
 #include <SPI.h>
+#include <string.h>
+#include <stdarg.h>
 #include "SHARPMemLCDTxt.h"
 #include "font.h"
 
@@ -11,11 +13,96 @@
 #define CMD_NOP  0x00
 #define CMD_VCOM 0x02
 
-volatile char spi_busy = 0;
+#define JOB_NONE   0                // types of rendering jobs
+#define JOB_TEXT   1
+#define JOB_BITMAP 2
+
+#define TRANSPOSE 0x01               // internal rotation flags
+#define FLIP_X    DISP_MIRROR
+#define FLIP_Y    0x08
+
+#if SHARP_SCALE                      // features disabled in SHARPMemLCDConfig.h become constants,
+#define SCALE_X m_scaleX             // code depending on them is removed by the compiler
+#define SCALE_Y m_scaleY
+#else
+#define SCALE_X 1
+#define SCALE_Y 1
+#endif
+
+#if SHARP_ROTATION
+#define ROTATION m_rotation
+#else
+#define ROTATION 0
+#endif
+
+#if SHARP_CACHE
+#define CACHE m_cache
+#else
+#define CACHE 0
+#endif
+
+#if SHARP_FONT_TABLES
+// font tables for each combination of DISP_INVERT and DISP_BOLD, derived from fontrows.h by the compiler
+// and indexed like font8x8, including blank row. Set bits are white unless DISP_INVERT, wide tables hold 16 pixels per row
+static const unsigned char fontWire[FONT_SIZE + 1] = {
+#define FONT_ROW(b) FONT_INV(b),
+#include "fontrows.h"
+#undef FONT_ROW
+};
+
+static const unsigned char fontBoldWire[FONT_SIZE + 1] = {
+#define FONT_ROW(b) FONT_INV(FONT_BOLD(b)),
+#include "fontrows.h"
+#undef FONT_ROW
+};
+
+static const unsigned char fontBold[FONT_SIZE + 1] = {
+#define FONT_ROW(b) FONT_BOLD(b),
+#include "fontrows.h"
+#undef FONT_ROW
+};
+
+static const unsigned int fontWideWire[FONT_SIZE + 1] = {
+#define FONT_ROW(b) FONT_WINV(b),
+#include "fontrows.h"
+#undef FONT_ROW
+};
+
+static const unsigned int fontWide[FONT_SIZE + 1] = {
+#define FONT_ROW(b) FONT_WIDE(b),
+#include "fontrows.h"
+#undef FONT_ROW
+};
+
+static const unsigned int fontWideBoldWire[FONT_SIZE + 1] = {
+#define FONT_ROW(b) FONT_WINV(FONT_BOLD(b)),
+#include "fontrows.h"
+#undef FONT_ROW
+};
+
+static const unsigned int fontWideBold[FONT_SIZE + 1] = {
+#define FONT_ROW(b) FONT_WIDE(FONT_BOLD(b)),
+#include "fontrows.h"
+#undef FONT_ROW
+};
+
+// index is (options & DISP_INVERT) | ((options & DISP_BOLD) >> 2)
+static const unsigned char* const fontRows[4] = { fontWire, font8x8, fontBoldWire, fontBold };
+static const unsigned int* const fontRowsWide[4] = { fontWideWire, fontWide, fontWideBoldWire, fontWideBold };
+#endif
+
+#define TRACE_START    0x40          // trace flags, first line of transaction
+#define TRACE_EXTCOMIN 0x80          // VCOM toggled with EXTCOMIN pin
+#define TRACE_PLAIN    0             // ways to read line data for trace
+#define TRACE_REVERSE  1
+#define TRACE_REPEAT   2
 
 SHARPMemLCDTxt::SHARPMemLCDTxt(char pinCS, char pinDISP, char pinVCOM)
-    : m_pinCS(pinCS), m_pinDISP(pinDISP), m_pinVCOM(pinVCOM), m_stateVCOM(0)
+    : m_pinCS(pinCS), m_pinDISP(pinDISP), m_pinVCOM(pinVCOM), m_stateVCOM(0), m_spiBusy(0),
+      m_scaleX(1), m_scaleY(1), m_rotation(0), m_frame(0), m_strip(0), m_band(0), m_cache(0), m_cacheEntries(0),
+      m_cacheHits(0), m_cacheMisses(0), m_job(JOB_NONE)
 {
+    memset(m_blank, 0, sizeof(m_blank));     // content of display is unknown until cleared
 }
 
 SHARPMemLCDTxt::~SHARPMemLCDTxt()
@@ -36,6 +123,12 @@ void SHARPMemLCDTxt::begin()
         m_millis = millis();
     }
 
+#ifdef SHARP_TRACE
+    m_traceNext = 0;
+    m_traceCount = 0;
+    m_traceStart = 0;
+#endif
+
     // configure SPI
     SPI.begin();
     SPI.setBitOrder(0);			// bit order LSB first
@@ -54,72 +147,704 @@ void SHARPMemLCDTxt::off()
 
 void SHARPMemLCDTxt::clear()
 {
-    spi_busy = 1;
+    if (m_frame) {                           // only clear frame buffer if attached
+        memset(m_frame, 0xff, PIXELS_X*PIXELS_Y/8);
+        return;
+    }
+    if (m_strip) {                           // or band, see firstBand
+        memset(m_strip, 0xff, PIXELS_Y);
+        return;
+    }
+
+    m_spiBusy = 1;
 
     SPI.setBitOrder(0);			// bit order LSB first
 
     digitalWrite(m_pinCS, HIGH);
     SPI.transfer(CMD_CLR | m_stateVCOM);
     SPI.transfer(0);
+#ifdef SHARP_TRACE
+    trace(CMD_CLR | m_stateVCOM, -1, 0, TRACE_PLAIN);
+#endif
     digitalWrite(m_pinCS, LOW);
 
-    spi_busy = 0;
+    m_spiBusy = 0;
+
+    memset(m_blank, 0xff, sizeof(m_blank));
 }
 
-void SHARPMemLCDTxt::print(const char* text, char line, char options)
+void SHARPMemLCDTxt::clear(int line, int count)
+{
+    if (!m_frame && !m_strip) {
+        // CMD_CLR costs 2 bytes, but also clears lines outside the range, which would have to be
+        // sent again. Their content is only known if they are blank, so it is used when all of
+        // them are. A burst costs 2 bytes plus PIXELS_X/8+2 bytes for each line in the range
+        // that is not blank yet, it is used otherwise.
+        int outside = 0;
+        int inside = 0;
+
+        for (int y = 0; y < PIXELS_Y; y++) {
+            if (!isBlank(physLine(y))) {
+                if (y >= line && y - line < count) {
+                    inside++;
+                } else {
+                    outside++;
+                }
+            }
+        }
+
+        if (inside && !outside) {
+            clear();
+            return;
+        }
+    }
+
+    fill(line, count, 0);                    // only sends lines that are not blank yet
+}
+
+void SHARPMemLCDTxt::fill(int line, int count, unsigned char pattern)
 {
     pulse(0);
 
-    SPI.setBitOrder(0);			// bit order LSB first
+    if (line < 0) {                          // skip lines above display
+        count += line;
+        line = 0;
+    }
 
-    // c = char
-    // b = bitmap
-    // i = text index
-    // j = line buffer index
+    pattern = ~pattern;                      // pixels are LOW active
+
+    if (m_frame) {                           // render into frame buffer if attached
+        while (count > 0 && line < PIXELS_Y) {
+            memset(m_frame + line*(PIXELS_X/8), pattern, PIXELS_X/8);
+            line++;
+            count--;
+        }
+        return;
+    }
+    if (m_strip) {                           // or band
+        while (count > 0 && line < PIXELS_Y) {
+            m_strip[line++] = pattern;
+            count--;
+        }
+        return;
+    }
+    if (ROTATION & TRANSPOSE) return;        // needs frame buffer or bands
+
+    unsigned char b = pattern;
+    if (ROTATION & FLIP_X) {            // mirrored pattern for horizontal flip
+        b = bitrev[pattern];
+    }
+
+    char open = 0;
+
+    while (count > 0 && line < PIXELS_Y) {   // stream pattern for all lines in one transaction
+        int phys = physLine(line++);
+        count--;
+
+        if (b == 0xff && isBlank(phys)) {    // blank lines are not sent again
+            continue;
+        }
+        if (!open) {                         // transaction is only started if a line is sent
+            beginWrite();
+            open = 1;
+        }
+
+#ifdef SHARP_TRACE
+        trace(CMD_WR | m_stateVCOM, phys, &b, TRACE_REPEAT);
+#endif
+        beginLine(phys);
+
+        char j = 0;
+        while (j < (PIXELS_X/8)) {
+            SPI.transfer(b);
+            j++;
+        }
+
+        endLine();
+        setBlank(phys, b == 0xff);
+    }
+
+    if (open) {
+        endWrite();
+    }
+}
+
+void SHARPMemLCDTxt::print(const char* text, int line, char options)
+{
+    pulse(0);
+
+    if (!textVisible(line, options)) return;
+
+    beginWrite();                                            // all lines of text are sent in one transaction
+    renderText(text, 0xff, line, options, SCALE_X, SCALE_Y);
+    endWrite();
+}
+
+// returns 0 if text printed at line with options would be outside of display
+char SHARPMemLCDTxt::textVisible(int line, char options)
+{
+    int height = 8 * SCALE_Y;
+
+    if (SHARP_SCALE && (options & DISP_HIGH)) {
+        height <<= 1;
+    }
+    return line < PIXELS_Y && line + height > 0;
+}
+
+// scale is passed by the caller, e.g. the console draws unscaled, regardless of setScale
+int SHARPMemLCDTxt::renderText(const char* text, unsigned char len, int line, char options,
+                               unsigned char scaleX, unsigned char scaleY)
+{
     // k = char line
-    unsigned char c, b, i, j, k;
+    // h = character line repeat
+    unsigned char k, h;
+
+    if (!SHARP_SCALE) {
+        scaleX = 1;
+        scaleY = 1;
+    }
+
+    if (SHARP_SCALE && (options & DISP_HIGH)) {              // DISP_HIGH doubles the current scale
+        scaleY <<= 1;
+    }
+
+    unsigned long hash = 0;
+    if (CACHE) {                                           // prepare lookup of rendered lines in cache
+        hash = hashText(text, len);
+        ageCache();
+    }
 
     // rendering happens line-by-line because this display can only be written by line
     k = 0;
     while (k < 8 && line < PIXELS_Y) { // loop for 8 character lines while within display
-        i = 0;
-        j = 0;
-        while (j < (PIXELS_X/8) && (c = text[i]) != 0) {     // while we did not reach end of line or string
-            if (c < ' ' || c > 'Z') {                        // invalid characters are replace with SPACE
-                c = ' ';
+        const unsigned char* data = (const unsigned char*)m_buffer;
+
+        if (CACHE) {                                         // use line from cache, render it if missing
+            data = cacheRow(text, len, k, options, scaleX, hash);
+        } else {
+            renderRow(text, len, k, options, scaleX);
+        }
+
+        h = scaleY;
+        do {                                                 // repeat line for vertical scale
+            writeData(line++, data);                         // write line to display
+        } while (--h && line < PIXELS_Y);
+
+        k++;                                                 // next pixel line
+    }
+
+    return line;
+}
+
+void SHARPMemLCDTxt::renderRow(const char* text, unsigned char len, unsigned char k, char options, unsigned char scale)
+{
+    // c = char
+    // b = bitmap
+    // i = text index
+    // j = line buffer index
+    // w = character width in bytes
+    unsigned char c, b, i, j, w;
+
+    if (!SHARP_SCALE) {
+        scale = 1;
+    }
+    unsigned char scaleX = scale;
+
+    if (SHARP_SCALE && (options & DISP_WIDE)) {              // DISP_WIDE doubles the current scale
+        scaleX <<= 1;
+    }
+
+#if SHARP_FONT_TABLES
+    unsigned char v = (options & DISP_INVERT) | ((options & DISP_BOLD) >> 2);
+    const unsigned char* rows = fontRows[v];                 // font table already transformed for options
+    const unsigned int* wide = fontRowsWide[v];
+    unsigned int n;
+#endif
+
+    i = 0;
+    j = 0;
+    while (j < (PIXELS_X/8) && i < len && (c = text[i]) != 0) {  // while we did not reach end of line or string
+        if (c < ' ' || c > 'Z') {                            // invalid characters are replace with SPACE
+            c = ' ';
+        }
+
+        w = scaleX;
+        if ((options & DISP_WIDE) && (c == ' ')) {           // SPACE is not widened by DISP_WIDE
+            w = scale;
+        }
+
+#if SHARP_FONT_TABLES
+        n = FONT_GLYPH(c);                                   // characters not in font use blank row
+        if (n < FONT_SIZE) {
+            n += k;
+        }
+
+        if (w == 2) {                                        // double width, copy 16 pixels from table
+            m_buffer[j++] = wide[n] >> 8;
+            if (j < (PIXELS_X/8)) {                          // clip at right edge of display
+                m_buffer[j++] = wide[n];
             }
+            i++;
+            continue;
+        }
+        b = rows[n];
+#else
+        b = glyphRow(c, k);                                  // retrieve byte defining one line of character
 
-            c = c - 32;                                      // convert character to index in font table
-            b = font8x8[(c*8)+k];                            // retrieve byte defining one line of character
+        if (options & DISP_BOLD) {                           // bold, smear pixels to the right
+            b |= b >> 1;
+        }
+        if (!(options & DISP_INVERT)) {                      // invert bits if DISP_INVERT is _NOT_ selected
+            b = ~b;// pixels are LOW active
+        }
+#endif
+
+        if (w > 1) {                                         // scaled rendering
+            expand(b, w, j);
+            j += w;                                          // we've written w bytes to buffer
+        } else {                                             // else regular rendering
+            m_buffer[j] = b;                                 // store pixels in line buffer
+            j++;                                             // we've written one byte to buffer
+        }
 
-            if (!(options & DISP_INVERT)) {                  // invert bits if DISP_INVERT is _NOT_ selected
-                b = ~b;// pixels are LOW active
+        i++;                                                 // next character
+    }
+
+    while (j < (PIXELS_X/8)) {                               // pad line for empty characters
+        m_buffer[j] = 0xff;
+        j++;
+    }
+}
+
+void SHARPMemLCDTxt::printf(int line, char options, const char* format, ...)
+{
+    // characters are formatted straight into text, which holds as many characters as fit on a line
+    // unscaled. formatting stops when it is full, as further characters would be clipped anyway
+    char text[PIXELS_X/8];
+    char digits[12];
+    unsigned char n = 0;
+    char c;
+
+    va_list args;
+    va_start(args, format);
+
+    while (n < PIXELS_X/8 && (c = *format++) != 0) {
+        if (c != '%') {                                      // regular character
+            text[n++] = c;
+            continue;
+        }
+
+        // parse %[-][0][width][.decimals][l]type
+        char left = 0;
+        char zero = 0;
+        char lng = 0;
+        unsigned char width = 0;
+        unsigned char decimals = 0;
+
+        c = *format++;
+        if (c == '-') {
+            left = 1;
+            c = *format++;
+        }
+        if (c == '0') {
+            zero = 1;
+            c = *format++;
+        }
+        while (c >= '0' && c <= '9') {
+            width = width*10 + c - '0';
+            c = *format++;
+        }
+        if (c == '.') {
+            c = *format++;
+            while (c >= '0' && c <= '9') {
+                decimals = decimals*10 + c - '0';
+                c = *format++;
             }
+        }
+        if (c == 'l') {
+            lng = 1;
+            c = *format++;
+        }
+
+        const char* str = digits;
+        unsigned char len = 0;
+        char sign = 0;
 
-            if ((options & DISP_WIDE) && (c != 0)) {         // double width rendering if DISP_WIDE and character is not SPACE
-                doubleWide(b, j);		             
-                j += 2;                                      // we've written two bytes to buffer
-            } else {                                         // else regular rendering
-                m_buffer[j] = b;                             // store pixels in line buffer
-                j++;                                         // we've written one byte to buffer
+        if (c == 'd' || c == 'i') {                          // signed decimal, optionally fixed point
+            long s = lng ? va_arg(args, long) : va_arg(args, int);
+            unsigned long v = s;
+            if (s < 0) {
+                sign = '-';
+                v = 0UL - v;                                 // negated unsigned, -LONG_MIN overflows a long
+            }
+            len = formatDecimal(digits, v, decimals);
+        } else if (c == 'u') {                               // unsigned decimal, optionally fixed point
+            unsigned long v = lng ? va_arg(args, unsigned long) : va_arg(args, unsigned int);
+            len = formatDecimal(digits, v, decimals);
+        } else if (c == 'x' || c == 'X') {                   // hexadecimal
+            unsigned long v = lng ? va_arg(args, unsigned long) : va_arg(args, unsigned int);
+            signed char shift = 28;
+            while (shift > 0 && (v >> shift) == 0) {         // skip leading zeros
+                shift -= 4;
             }
+            while (shift >= 0) {
+                unsigned char h = (v >> shift) & 0x0f;
+                digits[len++] = (h < 10) ? '0' + h : 'A' - 10 + h;
+                shift -= 4;
+            }
+        } else if (c == 'c') {                               // character
+            digits[len++] = va_arg(args, int);
+        } else if (c == 's') {                               // string
+            str = va_arg(args, const char*);
+            while (str[len] != 0 && len < PIXELS_X/8) {
+                len++;
+            }
+        } else if (c == 0) {                                 // format ends after %
+            break;
+        } else {                                             // %% and unknown types are shown as they are
+            digits[len++] = c;
+        }
 
-            i++;                                             // next character
+        unsigned char pad = 0;
+        if (width > len + (sign ? 1 : 0)) {
+            pad = width - len - (sign ? 1 : 0);
         }
 
-        while (j < (PIXELS_X/8)) {                           // pad line for empty characters
-            m_buffer[j] = 0xff;
-            j++;
+        if (sign && (zero || left) && n < PIXELS_X/8) {      // sign goes before zero padding
+            text[n++] = sign;
+            sign = 0;
+        }
+        while (!left && pad > 0 && n < PIXELS_X/8) {         // right aligned
+            text[n++] = zero ? '0' : ' ';
+            pad--;
+        }
+        if (sign && n < PIXELS_X/8) {
+            text[n++] = sign;
         }
+        unsigned char i = 0;
+        while (i < len && n < PIXELS_X/8) {
+            text[n++] = str[i++];
+        }
+        while (pad > 0 && n < PIXELS_X/8) {                  // left aligned
+            text[n++] = ' ';
+            pad--;
+        }
+    }
 
-        writeBuffer(line++);                                 // write line buffer to display
+    va_end(args);
 
-        if (options & DISP_HIGH && line < PIXELS_Y) {        // repeat line if DISP_HIGH is selected
-            writeBuffer(line++);
+    pulse(0);
+
+    if (!textVisible(line, options)) return;
+
+    beginWrite();                                            // all lines of text are sent in one transaction
+    renderText(text, n, line, options, SCALE_X, SCALE_Y);
+    endWrite();
+}
+
+static const unsigned long powers10[10] = {
+    1000000000UL, 100000000UL, 10000000UL, 1000000UL, 100000UL, 10000UL, 1000UL, 100UL, 10UL, 1UL
+};
+
+// split value into 10 decimal digits by subtracting powers of 10, as MSP430 has no hardware division
+void SHARPMemLCDTxt::toDecimal(unsigned long value, char* digits)
+{
+    unsigned char d = 0;
+
+    while (d < 10) {
+        char n = '0';
+        while (value >= powers10[d]) {
+            value -= powers10[d];
+            n++;
         }
+        digits[d++] = n;
+    }
+}
 
-        k++;                                                 // next pixel line
+// format value without leading zeros, with decimal point before the last decimals digits
+// returns number of characters written to out, at most 11
+unsigned char SHARPMemLCDTxt::formatDecimal(char* out, unsigned long value, unsigned char decimals)
+{
+    char digits[10];
+    unsigned char d = 0;
+    unsigned char n = 0;
+
+    if (decimals > 9) {
+        decimals = 9;
+    }
+
+    toDecimal(value, digits);
+
+    while (d < 9 - decimals && digits[d] == '0') {           // skip leading zeros, keep one before point
+        d++;
+    }
+    while (d < 10) {
+        if (decimals && d == 10 - decimals) {
+            out[n++] = '.';
+        }
+        out[n++] = digits[d++];
+    }
+
+    return n;
+}
+
+void SHARPMemLCDTxt::setCache(unsigned char* buffer, unsigned int size)
+{
+    m_cache = 0;
+    m_cacheEntries = 0;
+    m_cacheHits = 0;
+    m_cacheMisses = 0;
+
+    if (!SHARP_CACHE || !buffer) return;
+
+    unsigned char align = (size_t)buffer & (sizeof(unsigned long) - 1);
+    if (align) {                                             // align entries for access to hash
+        align = sizeof(unsigned long) - align;
+        if (size < align) return;
+        buffer += align;
+        size -= align;
+    }
+
+    unsigned int entries = size / sizeof(CacheEntry);
+    if (entries > 0xff) {
+        entries = 0xff;
+    }
+
+    m_cache = (CacheEntry*)buffer;
+    m_cacheEntries = entries;
+
+    unsigned char i = 0;
+    while (i < m_cacheEntries) {                             // mark all entries unused
+        m_cache[i].age = 0xff;
+        i++;
+    }
+}
+
+// FNV-1a hash of characters that fit on a line
+unsigned long SHARPMemLCDTxt::hashText(const char* text, unsigned char len)
+{
+    unsigned long hash = 2166136261UL;
+    unsigned char i = 0;
+
+    while (i < len && i < PIXELS_X/8 && text[i] != 0) {
+        hash = (hash ^ (unsigned char)text[i]) * 16777619UL;
+        i++;
+    }
+
+    return hash ^ i;
+}
+
+// make all entries one step older, entries that are not used keep age 0xff
+void SHARPMemLCDTxt::ageCache()
+{
+    unsigned char i = 0;
+
+    while (i < m_cacheEntries) {
+        if (m_cache[i].age < 0xfe) {
+            m_cache[i].age++;
+        }
+        i++;
+    }
+}
+
+// return pixel line k of text from cache, render it into least recently used entry if not found
+const unsigned char* SHARPMemLCDTxt::cacheRow(const char* text, unsigned char len, unsigned char k, char options,
+                                              unsigned char scale, unsigned long hash)
+{
+    unsigned char key = k | ((options & (DISP_INVERT | DISP_WIDE | DISP_BOLD)) << 3);
+    CacheEntry* oldest = 0;
+    unsigned char i = 0;
+
+    while (i < m_cacheEntries) {
+        CacheEntry* e = &m_cache[i++];
+        if (e->age != 0xff && e->hash == hash && e->key == key && e->scale == scale) {
+            e->age = 0;                                      // found, mark as most recently used
+            m_cacheHits++;
+            return e->data;
+        }
+        if (!oldest || e->age > oldest->age) {
+            oldest = e;
+        }
+    }
+
+    renderRow(text, len, k, options, scale);
+    m_cacheMisses++;
+
+    if (!oldest) {                                           // cache too small for a single entry
+        return (const unsigned char*)m_buffer;
     }
+
+    oldest->hash = hash;
+    oldest->key = key;
+    oldest->scale = scale;
+    oldest->age = 0;
+    memcpy(oldest->data, m_buffer, PIXELS_X/8);
+
+    return oldest->data;
+}
+
+void SHARPMemLCDTxt::setScale(char x, char y)
+{
+    if (!SHARP_SCALE) return;
+
+    if (x < 1) x = 1;
+    if (x > PIXELS_X/8) x = PIXELS_X/8;                      // one character must fit on a line
+    if (y < 1) y = 1;
+
+    m_scaleX = x;
+    m_scaleY = y;
+}
+
+// returns 0 if rotation is not supported and the current one is kept
+char SHARPMemLCDTxt::setRotation(char rotation)
+{
+    // rotation by 180 degrees is the same as flipping both axes
+    // 90 and 270 degrees swap axes, which is done by transposing the frame buffer on flush, or bands
+    // of 8 columns rendered one after the other. other output is dropped, as it can't be rotated.
+    // swapping axes needs a square display
+    static const unsigned char flips[4] = { 0, TRANSPOSE | FLIP_X, FLIP_X | FLIP_Y, TRANSPOSE | FLIP_Y };
+
+    unsigned char flip = flips[rotation & 3] ^ (rotation & DISP_MIRROR);
+
+    if (!SHARP_ROTATION) {
+        return flip == 0;
+    }
+    if ((flip & TRANSPOSE) && PIXELS_X != PIXELS_Y) {
+        return 0;
+    }
+    m_rotation = flip;
+    return 1;
+}
+
+void SHARPMemLCDTxt::attach(unsigned char* frame)
+{
+    m_frame = frame;
+}
+
+// if shadow is set, only lines that differ from it are sent, and shadow is updated
+void SHARPMemLCDTxt::flush(unsigned char* shadow)
+{
+    if (!m_frame) return;
+
+    pulse(0);
+
+    const unsigned char* frame = m_frame;
+    int line;
+    char open = 0;                           // frame buffer is sent in one transaction
+
+#if PIXELS_X == PIXELS_Y
+    if (ROTATION & TRANSPOSE) {            // columns of frame buffer become lines of display
+        unsigned char band[8][PIXELS_X/8];   // 8 lines are rendered at once from 8x8 pixel blocks
+        unsigned char block[8];
+        unsigned char bx, by, k;
+
+        line = 0;
+        bx = 0;
+        while (bx < PIXELS_X/8) {            // loop for each column of blocks
+            by = 0;
+            while (by < PIXELS_Y/8) {        // transpose each block in this column
+                transpose8(frame + by*PIXELS_X + bx, PIXELS_X/8, block);
+                k = 0;
+                while (k < 8) {
+                    band[k][by] = block[k];
+                    k++;
+                }
+                by++;
+            }
+            k = 0;
+            while (k < 8) {                  // send band of 8 lines
+                open = flushLine(line++, band[k], shadow, open);
+                k++;
+            }
+            bx++;
+        }
+    } else
+#endif
+    {
+        line = 0;
+        while (line < PIXELS_Y) {            // lines of frame buffer are sent as they are
+            open = flushLine(line, frame + line*(PIXELS_X/8), shadow, open);
+            line++;
+        }
+    }
+
+    if (open) {
+        endWrite(1);
+    }
+}
+
+// start rendering the screen in bands of 8 columns with 90 or 270 degrees rotation, instead of a frame
+// buffer. strip holds the band, PIXELS_Y bytes. all output for the screen must be drawn for each band,
+// until nextBand returns 0. with other rotations, output is sent as it is drawn, in a single pass
+void SHARPMemLCDTxt::firstBand(unsigned char* strip)
+{
+    m_band = 0;
+    if (PIXELS_X == PIXELS_Y && (ROTATION & TRANSPOSE)) {   // rotation by 90 degrees needs a square display
+        m_strip = strip;
+        memset(m_strip, 0xff, PIXELS_Y);
+    }
+}
+
+// send band drawn since firstBand or the previous call as 8 lines of the display
+// returns 1 if the next band needs to be drawn, 0 when the screen is complete
+char SHARPMemLCDTxt::nextBand()
+{
+#if PIXELS_X == PIXELS_Y
+    if (!m_strip) return 0;
+
+    pulse(0);
+
+    unsigned char band[8][PIXELS_X/8];       // strip holds byte column m_band of all lines
+    unsigned char by, k;
+
+    by = 0;
+    while (by < PIXELS_Y/8) {                // transpose each block of 8 lines
+        unsigned char block[8];
+        transpose8(m_strip + by*8, 1, block);
+        k = 0;
+        while (k < 8) {
+            band[k][by] = block[k];
+            k++;
+        }
+        by++;
+    }
+
+    char open = 0;
+    k = 0;
+    while (k < 8) {                          // columns of band become lines of display
+        open = flushLine(m_band*8 + k, band[k], 0, open);
+        k++;
+    }
+    endWrite(1);
+
+    if (++m_band < PIXELS_X/8) {
+        memset(m_strip, 0xff, PIXELS_Y);     // draw next band from blank
+        return 1;
+    }
+
+    m_strip = 0;
+#endif
+    return 0;
+}
+
+// send line unless it matches shadow, the transaction is started with the first line sent
+// returns 1 if the transaction is open
+char SHARPMemLCDTxt::flushLine(int line, const unsigned char* data, unsigned char* shadow, char open)
+{
+    if (shadow) {
+        unsigned char* s = shadow + line*(PIXELS_X/8);
+        if (memcmp(s, data, PIXELS_X/8) == 0) {
+            return open;
+        }
+        memcpy(s, data, PIXELS_X/8);
+    }
+
+    if (!open) {
+        beginWrite(1);
+    }
+    sendLine(line, data);
+
+    return 1;
 }
 
 void SHARPMemLCDTxt::pulse(int force)
@@ -140,94 +865,493 @@ void SHARPMemLCDTxt::pulse(int force)
             digitalWrite(m_pinVCOM, HIGH);
             delayMicroseconds(1);
             digitalWrite(m_pinVCOM, LOW);
+#ifdef SHARP_TRACE
+            if (!m_spiBusy) {
+                trace(TRACE_EXTCOMIN, -1, 0, TRACE_PLAIN);
+            }
+#endif
         } else {
             m_stateVCOM ^= CMD_VCOM;
-            if (!spi_busy) {
-                spi_busy = 1;
+            if (!m_spiBusy) {
+                m_spiBusy = 1;
                 SPI.setBitOrder(0);			// bit order LSB first
                 digitalWrite(m_pinCS, HIGH);
                 SPI.transfer(CMD_NOP | m_stateVCOM);
                 SPI.transfer(0);
+#ifdef SHARP_TRACE
+                trace(CMD_NOP | m_stateVCOM, -1, 0, TRACE_PLAIN);
+#endif
                 digitalWrite(m_pinCS, LOW);
-                spi_busy = 0;
+                m_spiBusy = 0;
             }
         }
     }
 }
 
-void SHARPMemLCDTxt::bitmap(const unsigned char* bitmap, int width, int height, char line, char options)
+void SHARPMemLCDTxt::bitmap(const unsigned char* bitmap, int width, int height, int line, char options)
 {
     pulse(0);
 
     SPI.setBitOrder(0);			// bit order LSB first
 
-    if (!bitmap) return;
+    if (!bitmap || height <= 0 || line >= PIXELS_Y || line + height * SCALE_Y <= 0) return;
+
+    unsigned char h;
+    int x = (width + 7) / 8;                    // rows are padded to full bytes
+
+    beginWrite();                               // all lines of bitmap are sent in one transaction
+
+    while (height > 0 && line < PIXELS_Y) {
+        renderBitmapRow(bitmap, width, options);
+        h = SCALE_Y;
+        do {                                    // repeat line for vertical scale
+            writeLine(line++);
+        } while (--h && line < PIXELS_Y);
+        bitmap += x;
+        height--;
+    }
 
+    endWrite();
+}
+
+void SHARPMemLCDTxt::renderBitmapRow(const unsigned char* bitmap, int width, char options)
+{
     unsigned char b;
+    int x = (width + 7) / 8;
     int i = 0;
-    int p = 0;
-    int x = width/8;
+    int j = 0;
 
-    while (height > 0 && line < PIXELS_Y) {
-        while (i < PIXELS_X/8 && i < x) {
-            b = bitmap[p+i];
-            if (!(options & DISP_INVERT)) {         // invert bits if DISP_INVERT is _NOT_ selected
-                b = ~b;// pixels are LOW active
+    while (j < PIXELS_X/8 && i < x) {
+        b = bitmap[i];
+        if (!(options & DISP_INVERT)) {         // invert bits if DISP_INVERT is _NOT_ selected
+            b = ~b;// pixels are LOW active
+        }
+        if (i == x - 1 && (width & 7)) {
+            b |= 0xff >> (width & 7);           // padding bits of last byte are white
+        }
+        if (SCALE_X > 1) {                      // scaled rendering
+            expand(b, SCALE_X, j);
+            j += SCALE_X;
+        } else {
+            m_buffer[j++] = b;
+        }
+        i++;
+    }
+    while (j < PIXELS_X/8) {                    // pad line right of bitmap
+        m_buffer[j++] = 0xff;
+    }
+}
+
+void SHARPMemLCDTxt::printAsync(const char* text, int line, char options)
+{
+    m_job = JOB_TEXT;
+    m_jobData = (const unsigned char*)text;
+    m_jobLine = line;
+    m_jobOptions = options;
+    m_jobRow = 0;
+    m_jobRows = 8;
+    m_jobRepeat = 0;
+    m_jobScale = SCALE_Y;
+    if (SHARP_SCALE && (options & DISP_HIGH)) { // DISP_HIGH doubles the current scale
+        m_jobScale <<= 1;
+    }
+}
+
+void SHARPMemLCDTxt::bitmapAsync(const unsigned char* bitmap, int width, int height, int line, char options)
+{
+    m_job = bitmap ? JOB_BITMAP : JOB_NONE;
+    m_jobData = bitmap;
+    m_jobWidth = width;
+    m_jobLine = line;
+    m_jobOptions = options;
+    m_jobRow = 0;
+    m_jobRows = height;
+    m_jobRepeat = 0;
+    m_jobScale = SCALE_Y;
+}
+
+// continue rendering job started with printAsync or bitmapAsync
+// lines are sent until budget microseconds have passed, at least one line per call
+// if budget is 0, job is completed. returns 1 when job is completed
+char SHARPMemLCDTxt::poll(unsigned int budget)
+{
+    if (m_job == JOB_NONE) return 1;
+
+    pulse(0);
+
+    unsigned long start = micros();
+    char rendered = 0;
+
+    if (m_jobLine >= PIXELS_Y || (m_jobRepeat == 0 && m_jobRow >= m_jobRows)) {
+        m_job = JOB_NONE;                       // nothing left to send, e.g. last call sent the last line
+        return 1;
+    }
+
+    beginWrite();                               // lines of this call are sent in one transaction
+
+    while (1) {
+        if (m_jobLine >= PIXELS_Y || (m_jobRepeat == 0 && m_jobRow >= m_jobRows)) {
+            m_job = JOB_NONE;                   // reached end of job or display
+            break;
+        }
+
+        if (m_jobRepeat == 0) {                 // next row of job
+            m_jobRow++;
+            m_jobRepeat = m_jobScale;
+            rendered = 0;
+        }
+
+        if (!rendered) {                        // line buffer may have been used since last call
+            if (m_job == JOB_TEXT) {
+                renderRow((const char*)m_jobData, 0xff, m_jobRow - 1, m_jobOptions, SCALE_X);
+            } else {
+                renderBitmapRow(m_jobData + (m_jobRow - 1) * ((m_jobWidth + 7) / 8), m_jobWidth, m_jobOptions);
             }
-            m_buffer[i] = b;
-            i++;
+            rendered = 1;
         }
-        writeBuffer(line);
-        p += x;
-        i = 0;
-        height--;
-        line++;
+
+        writeLine(m_jobLine++);
+        m_jobRepeat--;
+
+        if (budget && micros() - start >= budget) {
+            break;                              // time is up, continue with next call
+        }
+    }
+
+    endWrite();
+
+    return m_job == JOB_NONE;
+}
+
+char SHARPMemLCDTxt::busy()
+{
+    return m_job != JOB_NONE;
+}
+
+// lookup tables to widen a nibble of pixels by 2, 3 or 4
+static const unsigned char expand2[16] = {
+    0x00, 0x03, 0x0c, 0x0f, 0x30, 0x33, 0x3c, 0x3f, 0xc0, 0xc3, 0xcc, 0xcf, 0xf0, 0xf3, 0xfc, 0xff
+};
+
+static const unsigned int expand3[16] = {
+    0x000, 0x007, 0x038, 0x03f, 0x1c0, 0x1c7, 0x1f8, 0x1ff, 0xe00, 0xe07, 0xe38, 0xe3f, 0xfc0, 0xfc7, 0xff8, 0xfff
+};
+
+static const unsigned int expand4[16] = {
+    0x0000, 0x000f, 0x00f0, 0x00ff, 0x0f00, 0x0f0f, 0x0ff0, 0x0fff,
+    0xf000, 0xf00f, 0xf0f0, 0xf0ff, 0xff00, 0xff0f, 0xfff0, 0xffff
+};
+
+// lookup table to reverse bit order of a byte
+#define R2(n) n, n + 2*64, n + 1*64, n + 3*64
+#define R4(n) R2(n), R2(n + 2*16), R2(n + 1*16), R2(n + 3*16)
+#define R6(n) R4(n), R4(n + 2*4), R4(n + 1*4), R4(n + 3*4)
+
+const unsigned char SHARPMemLCDTxt::bitrev[256] = {
+    R6(0), R6(2), R6(1), R6(3)
+};
+
+// retrieve byte defining one line of character, invalid characters are shown as SPACE
+// characters that are not in the font stay blank
+unsigned char SHARPMemLCDTxt::glyphRow(unsigned char c, unsigned char k)
+{
+    if (c < ' ' || c > 'Z') {
+        c = ' ';
+    }
+    unsigned int n = FONT_GLYPH(c);
+    if (n == FONT_SIZE) {
+        return 0;
     }
+    return font8x8[n + k];
 }
 
-void SHARPMemLCDTxt::doubleWide(char b, char j)
+void SHARPMemLCDTxt::expand(unsigned char b, unsigned char scale, unsigned char j)
 {
-    int i = 8;
-    unsigned int c = 0;
+    unsigned char o[4];
+    unsigned char n = scale;
 
-    do {
-        c <<= 2;
-        if (b & 0x80) {
-            c |= 3;
+    if (j + n > PIXELS_X/8) {            // clip at right edge of display
+        n = PIXELS_X/8 - j;
+    }
+
+    if (scale == 2) {
+        o[0] = expand2[b >> 4];
+        o[1] = expand2[b & 0x0f];
+    } else if (scale == 3) {
+        unsigned int hi = expand3[b >> 4];
+        unsigned int lo = expand3[b & 0x0f];
+        o[0] = hi >> 4;
+        o[1] = (hi << 4) | (lo >> 8);
+        o[2] = lo;
+    } else if (scale == 4) {
+        unsigned int hi = expand4[b >> 4];
+        unsigned int lo = expand4[b & 0x0f];
+        o[0] = hi >> 8;
+        o[1] = hi;
+        o[2] = lo >> 8;
+        o[3] = lo;
+    } else {                             // larger scales repeat each pixel bit by bit
+        unsigned char c = 0;
+        unsigned char bits = 0;
+        unsigned char i = 8;
+        while (i != 0 && n != 0) {
+            unsigned char r = scale;
+            unsigned char p = (b & 0x80) ? 1 : 0;
+            while (r != 0 && n != 0) {
+                c = (c << 1) | p;
+                r--;
+                if (++bits == 8) {
+                    m_buffer[j++] = c;
+                    bits = 0;
+                    n--;
+                }
+            }
+            b <<= 1;
+            i--;
         }
-        b <<= 1;
-        i--;
-    } while (i != 0);
+        return;
+    }
 
-    m_buffer[j] = c >> 8;
-    m_buffer[j+1] = c & 0xff;
+    unsigned char i = 0;
+    while (i < n) {
+        m_buffer[j++] = o[i++];
+    }
 }
 
-void SHARPMemLCDTxt::writeBuffer(char line)
+void SHARPMemLCDTxt::writeBuffer(int line)
 {
-    if (line > PIXELS_Y) return;         // ignore writing to invalid lines
+    if (line < 0 || line >= PIXELS_Y) return;    // ignore writing to invalid lines
 
-    spi_busy = 1;
+    beginWrite();
+    writeLine(line);
+    endWrite();
+}
 
-    digitalWrite(m_pinCS, HIGH);
+void SHARPMemLCDTxt::writeLine(int line)
+{
+    writeData(line, (const unsigned char*)m_buffer);
+}
 
-    SPI.transfer(CMD_WR | m_stateVCOM);  // send command to write line(s)
+void SHARPMemLCDTxt::writeData(int line, const unsigned char* data)
+{
+    if (line < 0 || line >= PIXELS_Y) return;    // skip lines outside display, e.g. text partially above it
 
-    SPI.transfer(line+1);                // send line address
+    if (m_frame) {                           // render into frame buffer if attached
+        memcpy(m_frame + line*(PIXELS_X/8), data, PIXELS_X/8);
+        return;
+    }
+    if (m_strip) {                           // or keep the byte of the current band
+        m_strip[line] = data[m_band];
+        return;
+    }
+    if (ROTATION & TRANSPOSE) return;        // needs frame buffer or bands
 
-    SPI.setBitOrder(1);                  // switch SPI to MSB first for proper bitmap orientation
+    sendLine(line, data);
+}
+
+void SHARPMemLCDTxt::sendLine(int line, const unsigned char* data)
+{
+#ifdef SHARP_TRACE
+    trace(CMD_WR | m_stateVCOM, physLine(line), data, (ROTATION & FLIP_X) ? TRACE_REVERSE : TRACE_PLAIN);
+#endif
+    int phys = physLine(line);
+    unsigned char white = 0xff;
 
-    char j = 0;
-    while (j < (PIXELS_X/8)) {           // write pixels / 8 bytes
-        SPI.transfer(m_buffer[j++]);
+    beginLine(phys);
+
+    unsigned char j = 0;
+    if (ROTATION & FLIP_X) {            // horizontal flip, write pixels in reverse order
+        j = PIXELS_X/8;
+        while (j > 0) {
+            SPI.transfer(bitrev[data[--j]]);
+            white &= data[j];
+        }
+    } else {
+        while (j < (PIXELS_X/8)) {           // write pixels / 8 bytes
+            white &= data[j];
+            SPI.transfer(data[j++]);
+        }
     }
 
-    SPI.transfer(0);                     // transfer 16 bit to latch buffers and end transmission
-    SPI.transfer(0);
+    endLine();
+    setBlank(phys, white == 0xff);
+}
+
+// blank lines are white on the display, by line address as sent
+char SHARPMemLCDTxt::isBlank(int line)
+{
+    return (m_blank[line >> 3] >> (line & 7)) & 1;
+}
+
+void SHARPMemLCDTxt::setBlank(int line, char blank)
+{
+    if (blank) {
+        m_blank[line >> 3] |= 1 << (line & 7);
+    } else {
+        m_blank[line >> 3] &= ~(1 << (line & 7));
+    }
+}
+
+int SHARPMemLCDTxt::physLine(int line)
+{
+    if (ROTATION & FLIP_Y) {                 // vertical flip
+        return PIXELS_Y - 1 - line;
+    }
+    return line;
+}
+
+void SHARPMemLCDTxt::beginWrite(char force)
+{
+    if ((m_frame || m_strip || (ROTATION & TRANSPOSE)) && !force) return;  // nothing to send when rendering into buffer
+
+    m_spiBusy = 1;
 
-    SPI.setBitOrder(0);                  // switch SPI back to LSB first for commands
+    SPI.setBitOrder(0);                      // bit order LSB first
+
+    digitalWrite(m_pinCS, HIGH);
+
+    SPI.transfer(CMD_WR | m_stateVCOM);      // send command to write line(s)
+
+#ifdef SHARP_TRACE
+    m_traceStart = TRACE_START;
+#endif
+}
+
+void SHARPMemLCDTxt::beginLine(int line)
+{
+    SPI.transfer(line+1);                    // send line address
+
+    SPI.setBitOrder(1);                      // switch SPI to MSB first for proper bitmap orientation
+}
+
+void SHARPMemLCDTxt::endLine()
+{
+    SPI.transfer(0);                         // transfer 8 bit to latch line
+
+    SPI.setBitOrder(0);                      // switch SPI back to LSB first for commands
+}
+
+void SHARPMemLCDTxt::endWrite(char force)
+{
+    if ((m_frame || m_strip || (ROTATION & TRANSPOSE)) && !force) return;
+
+    SPI.transfer(0);                         // transfer another 8 bit to end transmission
 
     digitalWrite(m_pinCS, LOW);
 
-    spi_busy = 0;
+    m_spiBusy = 0;
+}
+
+// transpose block of 8x8 pixels, i.e. out[c] holds column c of in, top pixel in MSB
+void SHARPMemLCDTxt::transpose8(const unsigned char* in, int stride, unsigned char* out)
+{
+    unsigned long x, y, t;
+
+    x = ((unsigned long)in[0] << 24) | ((unsigned long)in[stride] << 16) |
+        ((unsigned int)in[2*stride] << 8) | in[3*stride];
+    y = ((unsigned long)in[4*stride] << 24) | ((unsigned long)in[5*stride] << 16) |
+        ((unsigned int)in[6*stride] << 8) | in[7*stride];
+
+    t = (x ^ (x >> 7)) & 0x00AA00AAUL;  x = x ^ t ^ (t << 7);      // swap 1x1 pixels
+    t = (y ^ (y >> 7)) & 0x00AA00AAUL;  y = y ^ t ^ (t << 7);
+
+    t = (x ^ (x >> 14)) & 0x0000CCCCUL; x = x ^ t ^ (t << 14);     // swap 2x2 pixel blocks
+    t = (y ^ (y >> 14)) & 0x0000CCCCUL; y = y ^ t ^ (t << 14);
+
+    t = (x & 0xF0F0F0F0UL) | ((y >> 4) & 0x0F0F0F0FUL);            // swap 4x4 pixel blocks
+    y = ((x << 4) & 0xF0F0F0F0UL) | (y & 0x0F0F0F0FUL);
+    x = t;
+
+    out[0] = x >> 24; out[1] = x >> 16; out[2] = x >> 8; out[3] = x;
+    out[4] = y >> 24; out[5] = y >> 16; out[6] = y >> 8; out[7] = y;
+}
+
+#ifdef SHARP_TRACE
+// record command or line sent to display, line is -1 for commands without line
+// data is traced as it appears on the wire, mode tells how to read it from data
+void SHARPMemLCDTxt::trace(unsigned char cmd, int line, const unsigned char* data, char mode)
+{
+    TraceRecord* r = &m_trace[m_traceNext];
+
+    if (++m_traceNext == SHARP_TRACE) {
+        m_traceNext = 0;
+    }
+    m_traceCount++;
+
+    r->time = millis();
+    r->cmd = cmd;
+    r->line = line + 1;
+    if (line >= 0) {
+        r->cmd |= m_traceStart;
+        m_traceStart = 0;
+    }
+
+    unsigned int hash = 0;
+    if (data) {
+        unsigned char j = 0;
+        while (j < PIXELS_X/8) {
+            unsigned char b;
+            if (mode == TRACE_REPEAT) {
+                b = data[0];
+            } else if (mode == TRACE_REVERSE) {
+                b = bitrev[data[PIXELS_X/8 - 1 - j]];
+            } else {
+                b = data[j];
+            }
+            hash = (((hash << 1) | (hash >> 15)) ^ b) & 0xffff;   // rotate and xor, cheap on MSP430
+#ifdef SHARP_TRACE_DATA
+            r->data[j] = b;
+#endif
+            j++;
+        }
+    }
+    r->hash = hash;
+}
+
+// print recorded trace, oldest record first, for decoding with tools/sharptrace.py
+// format of records is "T time cmd line hash [data]", time in milliseconds, other values in hex
+// data is only printed for lines, if SHARP_TRACE_DATA is defined
+void SHARPMemLCDTxt::traceDump(Print& out)
+{
+    unsigned char i = m_traceNext;
+    unsigned char n = SHARP_TRACE;
+
+    if (m_traceCount < SHARP_TRACE) {            // ring buffer not filled yet
+        i = 0;
+        n = m_traceCount;
+    }
+
+    out.print("# SHARP trace ");
+    out.print(m_traceCount);
+    out.print(' ');
+    out.print(PIXELS_X);
+    out.print(' ');
+    out.println(PIXELS_Y);
+
+    while (n--) {
+        const TraceRecord* r = &m_trace[i];
+        out.print("T ");
+        out.print(r->time);
+        out.print(' ');
+        out.print(r->cmd, HEX);
+        out.print(' ');
+        out.print(r->line, HEX);
+        out.print(' ');
+        out.print(r->hash, HEX);
+#ifdef SHARP_TRACE_DATA
+        if (r->line) {                          // only lines have data
+            out.print(' ');
+            unsigned char j = 0;
+            while (j < PIXELS_X/8) {
+                if (r->data[j] < 0x10) out.print('0');
+                out.print(r->data[j++], HEX);
+            }
+        }
+#endif
+        out.println();
+        if (++i == SHARP_TRACE) {
+            i = 0;
+        }
+    }
 }
+#endif
@@ -7,27 +7,117 @@
 #define DISP_INVERT 1
 #define DISP_WIDE 2
 #define DISP_HIGH 4
+#define DISP_BOLD 8
 
-#ifndef PIXELS_X
-#define PIXELS_X 96
-#endif
+#define DISP_ROT_0 0
+#define DISP_ROT_90 1
+#define DISP_ROT_180 2
+#define DISP_ROT_270 3
+#define DISP_MIRROR 4
+
+#include "SHARPMemLCDConfig.h"
 
-#ifndef PIXELS_Y
-#define PIXELS_Y 96
+#ifdef SHARP_TRACE
+#include <Print.h>
 #endif
 
 class SHARPMemLCDTxt
 {
+    friend class SHARPMemLCDConsole;
+    friend class SHARPMemLCDDither;
+    friend class SHARPMemLCDGray;
+    friend class SHARPMemLCDAnim;
+    friend class SHARPMemLCDChart;
+    friend class SHARPMemLCDNumber;
+    friend class SHARPMemLCDSink;
+
 private:
+    struct CacheEntry {                         // rendered pixel line of text
+        unsigned long hash;
+        unsigned char key;
+        unsigned char scale;
+        unsigned char age;
+        unsigned char data[PIXELS_X/8];
+    };
+
+#ifdef SHARP_TRACE
+    struct TraceRecord {                        // one command or line sent to display
+        unsigned long time;
+        unsigned char cmd;                      // command byte as sent, plus TRACE_ flags
+        unsigned char line;                     // line address as sent, 0 for commands without line
+        unsigned int hash;
+#ifdef SHARP_TRACE_DATA
+        unsigned char data[PIXELS_X/8];
+#endif
+    };
+#endif
+
     char m_pinCS;
     char m_pinDISP;
     char m_pinVCOM;
     char m_stateVCOM;
+    volatile char m_spiBusy;                    // transaction of this display open, VCOM is sent with next command
     unsigned long m_millis;
     char m_buffer[PIXELS_X/8];
+    unsigned char m_scaleX;
+    unsigned char m_scaleY;
+    unsigned char m_rotation;
+    unsigned char* m_frame;
+    unsigned char* m_strip;                     // band rendered with 90 or 270 degrees rotation
+    unsigned char m_band;                       // byte column of band
+    CacheEntry* m_cache;
+    unsigned char m_cacheEntries;
+    unsigned int m_cacheHits;                   // rows found in cache since setCache
+    unsigned int m_cacheMisses;                 // rows rendered into cache since setCache
+    unsigned char m_blank[(PIXELS_Y + 7)/8];    // bit per line known to be white, see clear(line, count)
 
-    void writeBuffer(char line);
-    void doubleWide(char b, char j);
+    char m_job;                                 // state of rendering job
+    const unsigned char* m_jobData;
+    int m_jobWidth;                             // width of bitmap in pixels
+    int m_jobLine;
+    char m_jobOptions;
+    int m_jobRow;
+    int m_jobRows;
+    unsigned char m_jobRepeat;
+    unsigned char m_jobScale;
+
+#ifdef SHARP_TRACE
+    TraceRecord m_trace[SHARP_TRACE];
+    unsigned char m_traceNext;                  // index of next record in ring buffer
+    unsigned long m_traceCount;                 // number of records since begin
+    unsigned char m_traceStart;                 // set for first line of transaction
+#endif
+
+    static const unsigned char bitrev[256];
+
+    void writeBuffer(int line);
+    void beginWrite(char force = 0);
+    void beginLine(int line);
+    void endLine();
+    void endWrite(char force = 0);
+    char textVisible(int line, char options);
+    int renderText(const char* text, unsigned char len, int line, char options, unsigned char scaleX, unsigned char scaleY);
+    void renderRow(const char* text, unsigned char len, unsigned char k, char options, unsigned char scale);
+    void writeLine(int line);
+    void writeData(int line, const unsigned char* data);
+    unsigned long hashText(const char* text, unsigned char len);
+    void ageCache();
+    const unsigned char* cacheRow(const char* text, unsigned char len, unsigned char k, char options, unsigned char scale,
+                                  unsigned long hash);
+    void sendLine(int line, const unsigned char* data);
+    int physLine(int line);
+    char isBlank(int line);
+    void setBlank(int line, char blank);
+    static void toDecimal(unsigned long value, char* digits);
+    static unsigned char formatDecimal(char* out, unsigned long value, unsigned char decimals);
+    static void transpose8(const unsigned char* in, int stride, unsigned char* out);
+    void renderBitmapRow(const unsigned char* bitmap, int width, char options);
+    void expand(unsigned char b, unsigned char scale, unsigned char j);
+    char flushLine(int line, const unsigned char* data, unsigned char* shadow, char open);
+    static unsigned char glyphRow(unsigned char c, unsigned char k);
+#ifdef SHARP_TRACE
+    void trace(unsigned char cmd, int line, const unsigned char* data, char mode);
+#endif
 
 public:
     SHARPMemLCDTxt(char pinCS = 13,
@@ -36,11 +126,30 @@ public:
     ~SHARPMemLCDTxt();
     void begin();
     void clear();
+    void clear(int line, int count);
     void on();
     void off();
-    void print(const char* text, char line, char options = 0);
+    void print(const char* text, int line, char options = 0);
+    void printf(int line, char options, const char* format, ...);
     void pulse(int force = 0);
-    void bitmap(const unsigned char* bitmap, int width, int height, char line, char options = 0);
+    void bitmap(const unsigned char* bitmap, int width, int height, int line, char options = 0);
+    void setScale(char x, char y);
+    void printAsync(const char* text, int line, char options = 0);
+    void bitmapAsync(const unsigned char* bitmap, int width, int height, int line, char options = 0);
+    char poll(unsigned int budget = 0);
+    char busy();
+    void fill(int line, int count, unsigned char pattern = 0);
+    char setRotation(char rotation);
+    void setCache(unsigned char* buffer, unsigned int size);
+    unsigned int cacheHits() { return m_cacheHits; }
+    unsigned int cacheMisses() { return m_cacheMisses; }
+    void attach(unsigned char* frame);
+    void flush(unsigned char* shadow = 0);
+    void firstBand(unsigned char* strip);
+    char nextBand();
+#ifdef SHARP_TRACE
+    void traceDump(Print& out);
+#endif
 };
 
 #endif
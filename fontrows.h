@@ -0,0 +1,662 @@
+/*
+ * fontrows.h
+ *
+ *  Rows of 8x8 font, see font.h
+ */
+
+// Included by font.h and wherever a table is derived from the font. Define FONT_ROW(b) to the
+// expression of a table entry before including, e.g. b followed by a comma for the plain font.
+// Only characters from SHARP_FONT_FIRST to SHARP_FONT_LAST are included, followed by a blank row.
+
+#if FONT_HAS(32)
+		/*   0 ' ' */
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(33)
+		/*   1 '!' */
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(34)
+		/*   2 '"' */
+		    /* 01101100 */  FONT_ROW(0x6c)
+		    /* 01101100 */  FONT_ROW(0x6c)
+		    /* 01101100 */  FONT_ROW(0x6c)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(35)
+		/*   3 '#' */
+		    /* 01101100 */  FONT_ROW(0x6c)
+		    /* 01101100 */  FONT_ROW(0x6c)
+		    /* 11111110 */  FONT_ROW(0xfe)
+		    /* 01101100 */  FONT_ROW(0x6c)
+		    /* 11111110 */  FONT_ROW(0xfe)
+		    /* 01101100 */  FONT_ROW(0x6c)
+		    /* 01101100 */  FONT_ROW(0x6c)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(36)
+		/*   4 '$' */
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 01111110 */  FONT_ROW(0x7e)
+		    /* 11011000 */  FONT_ROW(0xd8)
+		    /* 01111100 */  FONT_ROW(0x7c)
+		    /* 00011010 */  FONT_ROW(0x1a)
+		    /* 11111100 */  FONT_ROW(0xfc)
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(37)
+		/*   5 '%' */
+		    /* 01100000 */  FONT_ROW(0x60)
+		    /* 01100110 */  FONT_ROW(0x66)
+		    /* 00001100 */  FONT_ROW(0xc)
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 01100110 */  FONT_ROW(0x66)
+		    /* 01000110 */  FONT_ROW(0x46)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(38)
+		/*   6 '&' */
+		    /* 01110000 */  FONT_ROW(0x70)
+		    /* 11011000 */  FONT_ROW(0xd8)
+		    /* 11010000 */  FONT_ROW(0xd0)
+		    /* 01110000 */  FONT_ROW(0x70)
+		    /* 11011010 */  FONT_ROW(0xda)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 01111010 */  FONT_ROW(0x7a)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(39)
+		/*   7 ''' */
+		    /* 00111000 */  FONT_ROW(0x38)
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(40)
+		/*   8 '(' */
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 01100000 */  FONT_ROW(0x60)
+		    /* 01100000 */  FONT_ROW(0x60)
+		    /* 01100000 */  FONT_ROW(0x60)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(41)
+		/*   9 ')' */
+		    /* 01100000 */  FONT_ROW(0x60)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 01100000 */  FONT_ROW(0x60)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(42)
+		/*   a '*' */
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 10110100 */  FONT_ROW(0xb4)
+		    /* 01111000 */  FONT_ROW(0x78)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 01111000 */  FONT_ROW(0x78)
+		    /* 10110100 */  FONT_ROW(0xb4)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(43)
+		/*   b '+' */
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 11111100 */  FONT_ROW(0xfc)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(44)
+		/*   c ',' */
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 11100000 */  FONT_ROW(0xe0)
+		    /* 01100000 */  FONT_ROW(0x60)
+		    /* 11000000 */  FONT_ROW(0xc0)
+#endif
+#if FONT_HAS(45)
+		/*   d '-' */
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 01111100 */  FONT_ROW(0x7c)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(46)
+		/*   e '.' */
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 01110000 */  FONT_ROW(0x70)
+		    /* 01110000 */  FONT_ROW(0x70)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(47)
+		/*   f '/' */
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00001100 */  FONT_ROW(0xc)
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 01100000 */  FONT_ROW(0x60)
+		    /* 11000000 */  FONT_ROW(0xc0)
+		    /* 10000000 */  FONT_ROW(0x80)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(48)
+		/*  10 '0' */
+		    /* 00111000 */  FONT_ROW(0x38)
+		    /* 11000110 */  FONT_ROW(0xc6)
+		    /* 11001110 */  FONT_ROW(0xce)
+		    /* 11010110 */  FONT_ROW(0xd6)
+		    /* 11100110 */  FONT_ROW(0xe6)
+		    /* 11000110 */  FONT_ROW(0xc6)
+		    /* 00111000 */  FONT_ROW(0x38)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(49)
+		/*  11 '1' */
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 01110000 */  FONT_ROW(0x70)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 01111000 */  FONT_ROW(0x78)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(50)
+		/*  12 '2' */
+		    /* 01111000 */  FONT_ROW(0x78)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 00001100 */  FONT_ROW(0xc)
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 01100000 */  FONT_ROW(0x60)
+		    /* 11111100 */  FONT_ROW(0xfc)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(51)
+		/*  13 '3' */
+		    /* 11111100 */  FONT_ROW(0xfc)
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 00001100 */  FONT_ROW(0xc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 01111000 */  FONT_ROW(0x78)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(52)
+		/*  14 '4' */
+		    /* 00111000 */  FONT_ROW(0x38)
+		    /* 01111000 */  FONT_ROW(0x78)
+		    /* 11011000 */  FONT_ROW(0xd8)
+		    /* 10011000 */  FONT_ROW(0x98)
+		    /* 11111100 */  FONT_ROW(0xfc)
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(53)
+		/*  15 '5' */
+		    /* 11111100 */  FONT_ROW(0xfc)
+		    /* 11000000 */  FONT_ROW(0xc0)
+		    /* 11111000 */  FONT_ROW(0xf8)
+		    /* 00001100 */  FONT_ROW(0xc)
+		    /* 00001100 */  FONT_ROW(0xc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 01111000 */  FONT_ROW(0x78)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(54)
+		/*  16 '6' */
+		    /* 00111000 */  FONT_ROW(0x38)
+		    /* 01100000 */  FONT_ROW(0x60)
+		    /* 11000000 */  FONT_ROW(0xc0)
+		    /* 11111000 */  FONT_ROW(0xf8)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 01111000 */  FONT_ROW(0x78)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(55)
+		/*  17 '7' */
+		    /* 11111100 */  FONT_ROW(0xfc)
+		    /* 00001100 */  FONT_ROW(0xc)
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 01100000 */  FONT_ROW(0x60)
+		    /* 01100000 */  FONT_ROW(0x60)
+		    /* 01100000 */  FONT_ROW(0x60)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(56)
+		/*  18 '8' */
+		    /* 01111000 */  FONT_ROW(0x78)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 01111000 */  FONT_ROW(0x78)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 01111000 */  FONT_ROW(0x78)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(57)
+		/*  19 '9' */
+		    /* 01111000 */  FONT_ROW(0x78)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 01111100 */  FONT_ROW(0x7c)
+		    /* 00001100 */  FONT_ROW(0xc)
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 01110000 */  FONT_ROW(0x70)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(58)
+		/*  1a ':' */
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00111000 */  FONT_ROW(0x38)
+		    /* 00111000 */  FONT_ROW(0x38)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00111000 */  FONT_ROW(0x38)
+		    /* 00111000 */  FONT_ROW(0x38)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(59)
+		/*  1b ';' */
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00111000 */  FONT_ROW(0x38)
+		    /* 00111000 */  FONT_ROW(0x38)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00111000 */  FONT_ROW(0x38)
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(60)
+		/*  1c '<' */
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 01100000 */  FONT_ROW(0x60)
+		    /* 11000000 */  FONT_ROW(0xc0)
+		    /* 01100000 */  FONT_ROW(0x60)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(61)
+		/*  1d '=' */
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 01111100 */  FONT_ROW(0x7c)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 01111100 */  FONT_ROW(0x7c)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(62)
+		/*  1e '>' */
+		    /* 01100000 */  FONT_ROW(0x60)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 00001100 */  FONT_ROW(0xc)
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 01100000 */  FONT_ROW(0x60)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(63)
+		/*  1f '?' */
+		    /* 01111000 */  FONT_ROW(0x78)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 00001100 */  FONT_ROW(0xc)
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 00000000 */  FONT_ROW(0)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(64)
+		/*  20 '@' */
+		    /* 00111000 */  FONT_ROW(0x38)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11010110 */  FONT_ROW(0xd6)
+		    /* 11010110 */  FONT_ROW(0xd6)
+		    /* 11011100 */  FONT_ROW(0xdc)
+		    /* 11000000 */  FONT_ROW(0xc0)
+		    /* 00111000 */  FONT_ROW(0x38)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(65)
+		/*  21 'A' */
+		    /* 01111000 */  FONT_ROW(0x78)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11111100 */  FONT_ROW(0xfc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(66)
+		/*  22 'B' */
+		    /* 11111000 */  FONT_ROW(0xf8)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11111000 */  FONT_ROW(0xf8)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11111000 */  FONT_ROW(0xf8)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(67)
+		/*  23 'C' */
+		    /* 01111000 */  FONT_ROW(0x78)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11000000 */  FONT_ROW(0xc0)
+		    /* 11000000 */  FONT_ROW(0xc0)
+		    /* 11000000 */  FONT_ROW(0xc0)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 01111000 */  FONT_ROW(0x78)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(68)
+		/*  24 'D' */
+		    /* 11110000 */  FONT_ROW(0xf0)
+		    /* 11011000 */  FONT_ROW(0xd8)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11011000 */  FONT_ROW(0xd8)
+		    /* 11110000 */  FONT_ROW(0xf0)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(69)
+		/*  25 'E' */
+		    /* 11111100 */  FONT_ROW(0xfc)
+		    /* 11000000 */  FONT_ROW(0xc0)
+		    /* 11000000 */  FONT_ROW(0xc0)
+		    /* 11111000 */  FONT_ROW(0xf8)
+		    /* 11000000 */  FONT_ROW(0xc0)
+		    /* 11000000 */  FONT_ROW(0xc0)
+		    /* 11111100 */  FONT_ROW(0xfc)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(70)
+		/*  26 'F' */
+		    /* 11111100 */  FONT_ROW(0xfc)
+		    /* 11000000 */  FONT_ROW(0xc0)
+		    /* 11000000 */  FONT_ROW(0xc0)
+		    /* 11111000 */  FONT_ROW(0xf8)
+		    /* 11000000 */  FONT_ROW(0xc0)
+		    /* 11000000 */  FONT_ROW(0xc0)
+		    /* 11000000 */  FONT_ROW(0xc0)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(71)
+		/*  27 'G' */
+		    /* 01111000 */  FONT_ROW(0x78)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11000000 */  FONT_ROW(0xc0)
+		    /* 11011100 */  FONT_ROW(0xdc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 01111100 */  FONT_ROW(0x7c)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(72)
+		/*  28 'H' */
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11111100 */  FONT_ROW(0xfc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(73)
+		/*  29 'I' */
+		    /* 01111110 */  FONT_ROW(0x7e)
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 01111110 */  FONT_ROW(0x7e)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(74)
+		/*  2a 'J' */
+		    /* 00111100 */  FONT_ROW(0x3c)
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 11011000 */  FONT_ROW(0xd8)
+		    /* 01110000 */  FONT_ROW(0x70)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(75)
+		/*  2b 'K' */
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11011000 */  FONT_ROW(0xd8)
+		    /* 11110000 */  FONT_ROW(0xf0)
+		    /* 11100000 */  FONT_ROW(0xe0)
+		    /* 11110000 */  FONT_ROW(0xf0)
+		    /* 11011000 */  FONT_ROW(0xd8)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(76)
+		/*  2c 'L' */
+		    /* 11000000 */  FONT_ROW(0xc0)
+		    /* 11000000 */  FONT_ROW(0xc0)
+		    /* 11000000 */  FONT_ROW(0xc0)
+		    /* 11000000 */  FONT_ROW(0xc0)
+		    /* 11000000 */  FONT_ROW(0xc0)
+		    /* 11000000 */  FONT_ROW(0xc0)
+		    /* 11111100 */  FONT_ROW(0xfc)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(77)
+		/*  2d 'M' */
+		    /* 11000110 */  FONT_ROW(0xc6)
+		    /* 11101110 */  FONT_ROW(0xee)
+		    /* 11111110 */  FONT_ROW(0xfe)
+		    /* 11010110 */  FONT_ROW(0xd6)
+		    /* 11000110 */  FONT_ROW(0xc6)
+		    /* 11000110 */  FONT_ROW(0xc6)
+		    /* 11000110 */  FONT_ROW(0xc6)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(78)
+		/*  2e 'N' */
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11101100 */  FONT_ROW(0xec)
+		    /* 11111100 */  FONT_ROW(0xfc)
+		    /* 11011100 */  FONT_ROW(0xdc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(79)
+		/*  2f 'O' */
+		    /* 01111000 */  FONT_ROW(0x78)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 01111000 */  FONT_ROW(0x78)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(80)
+		/*  30 'P' */
+		    /* 11111000 */  FONT_ROW(0xf8)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11111000 */  FONT_ROW(0xf8)
+		    /* 11000000 */  FONT_ROW(0xc0)
+		    /* 11000000 */  FONT_ROW(0xc0)
+		    /* 11000000 */  FONT_ROW(0xc0)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(81)
+		/*  31 'Q' */
+		    /* 01111100 */  FONT_ROW(0x7c)
+		    /* 11000110 */  FONT_ROW(0xc6)
+		    /* 11000110 */  FONT_ROW(0xc6)
+		    /* 11000110 */  FONT_ROW(0xc6)
+		    /* 11010110 */  FONT_ROW(0xd6)
+		    /* 11001000 */  FONT_ROW(0xc8)
+		    /* 01110100 */  FONT_ROW(0x74)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(82)
+		/*  32 'R' */
+		    /* 11111000 */  FONT_ROW(0xf8)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11111000 */  FONT_ROW(0xf8)
+		    /* 11110000 */  FONT_ROW(0xf0)
+		    /* 11011000 */  FONT_ROW(0xd8)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(83)
+		/*  33 'S' */
+		    /* 01111100 */  FONT_ROW(0x7c)
+		    /* 11000000 */  FONT_ROW(0xc0)
+		    /* 11000000 */  FONT_ROW(0xc0)
+		    /* 01111000 */  FONT_ROW(0x78)
+		    /* 00001100 */  FONT_ROW(0xc)
+		    /* 00001100 */  FONT_ROW(0xc)
+		    /* 11111000 */  FONT_ROW(0xf8)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(84)
+		/*  34 'T' */
+		    /* 11111100 */  FONT_ROW(0xfc)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(85)
+		/*  35 'U' */
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 01111000 */  FONT_ROW(0x78)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(86)
+		/*  36 'V' */
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 01111000 */  FONT_ROW(0x78)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(87)
+		/*  37 'W' */
+		    /* 11000110 */  FONT_ROW(0xc6)
+		    /* 11000110 */  FONT_ROW(0xc6)
+		    /* 11000110 */  FONT_ROW(0xc6)
+		    /* 11010110 */  FONT_ROW(0xd6)
+		    /* 11010110 */  FONT_ROW(0xd6)
+		    /* 11111110 */  FONT_ROW(0xfe)
+		    /* 01101100 */  FONT_ROW(0x6c)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(88)
+		/*  38 'X' */
+		    /* 11000110 */  FONT_ROW(0xc6)
+		    /* 11000110 */  FONT_ROW(0xc6)
+		    /* 01101100 */  FONT_ROW(0x6c)
+		    /* 00111000 */  FONT_ROW(0x38)
+		    /* 01101100 */  FONT_ROW(0x6c)
+		    /* 11000110 */  FONT_ROW(0xc6)
+		    /* 11000110 */  FONT_ROW(0xc6)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(89)
+		/*  39 'Y' */
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 11001100 */  FONT_ROW(0xcc)
+		    /* 01111000 */  FONT_ROW(0x78)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+#if FONT_HAS(90)
+		/*  3a 'Z' */
+		    /* 11111100 */  FONT_ROW(0xfc)
+		    /* 00001100 */  FONT_ROW(0xc)
+		    /* 00011000 */  FONT_ROW(0x18)
+		    /* 00110000 */  FONT_ROW(0x30)
+		    /* 01100000 */  FONT_ROW(0x60)
+		    /* 11000000 */  FONT_ROW(0xc0)
+		    /* 11111100 */  FONT_ROW(0xfc)
+		    /* 00000000 */  FONT_ROW(0)
+#endif
+
+		/* blank row at index FONT_SIZE, for characters not included */
+		    /* 00000000 */  FONT_ROW(0)
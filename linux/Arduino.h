@@ -0,0 +1,32 @@
+// Subset of the Arduino API used by SHARPMemLCDTxt, for building the library and its examples on Linux.
+// Distributed under MIT License, see license.txt for details.
+
+#ifndef __ARDUINO_H__
+#define __ARDUINO_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "Print.h"
+#include "HardwareSerial.h"
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+
+#ifndef F_CPU
+#define F_CPU 16000000L                         // only used to compute SPI clock dividers
+#endif
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+#endif
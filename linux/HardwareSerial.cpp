@@ -0,0 +1,103 @@
+// Serial of the Arduino API on Linux, see HardwareSerial.h.
+// Distributed under MIT License, see license.txt for details.
+
+#include <Arduino.h>
+#include "HardwareSerial.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+HardwareSerial Serial;
+
+HardwareSerial::HardwareSerial()
+    : m_in(0), m_out(1), m_end(0), m_head(0), m_tail(0)
+{
+}
+
+// read and write fd instead of stdin and stdout, call before begin
+void HardwareSerial::attach(int fd)
+{
+    m_in = fd;
+    m_out = fd;
+    m_end = 0;
+    m_head = m_tail = 0;
+}
+
+void HardwareSerial::begin(unsigned long baud)
+{
+    static const struct { unsigned long baud; speed_t speed; } speeds[] = {
+        { 9600, B9600 }, { 19200, B19200 }, { 38400, B38400 }, { 57600, B57600 }, { 115200, B115200 }
+    };
+    int fds[2] = { m_in, m_out };
+
+    for (int i = 0; i < 2; i++) {
+        struct termios t;
+        if (tcgetattr(fds[i], &t) < 0) continue;    // not a tty
+
+        cfmakeraw(&t);
+        for (unsigned int k = 0; k < sizeof(speeds) / sizeof(speeds[0]); k++) {
+            if (speeds[k].baud == baud) {
+                cfsetspeed(&t, speeds[k].speed);
+            }
+        }
+        tcsetattr(fds[i], TCSANOW, &t);
+    }
+}
+
+void HardwareSerial::end()
+{
+    flush();
+}
+
+// returns bytes that can be read without waiting
+int HardwareSerial::available()
+{
+    if (m_head == m_tail) {
+        struct pollfd p;
+        p.fd = m_in;
+        p.events = POLLIN;
+
+        if (poll(&p, 1, 0) > 0) {
+            ssize_t n = ::read(m_in, m_buffer, SERIAL_BUFFER);
+            if (n > 0) {
+                m_head = 0;
+                m_tail = n;
+                m_end = 0;
+            } else if (n == 0 || errno != EAGAIN) {
+                m_end = 1;                      // end of file, or no process has the pseudo terminal open
+            }
+        }
+    }
+
+    return m_tail - m_head;
+}
+
+int HardwareSerial::read()
+{
+    return available() ? m_buffer[m_head++] : -1;
+}
+
+int HardwareSerial::peek()
+{
+    return available() ? m_buffer[m_head] : -1;
+}
+
+void HardwareSerial::flush()
+{
+    tcdrain(m_out);
+}
+
+size_t HardwareSerial::write(uint8_t c)
+{
+    while (::write(m_out, &c, 1) < 0) {
+        if (errno != EINTR && errno != EAGAIN) return 0;
+    }
+    return 1;
+}
+
+HardwareSerial::operator bool()
+{
+    return available() || !m_end;
+}
@@ -0,0 +1,41 @@
+// Serial of the Arduino API on Linux, reads stdin and writes stdout unless attached to another file.
+// Distributed under MIT License, see license.txt for details.
+//
+// A tty, e.g. the slave or master of a pseudo terminal, is set to raw mode by begin, so sketches
+// that talk a binary protocol can be run against the same clients as on a board. Serial is false
+// while the input is at its end, or no process has the other side of a pseudo terminal open.
+
+#ifndef __HARDWARESERIAL_H__
+#define __HARDWARESERIAL_H__
+
+#include "Stream.h"
+
+#define SERIAL_BUFFER 64
+
+class HardwareSerial : public Stream
+{
+private:
+    int m_in;
+    int m_out;
+    char m_end;                                 // no more input
+    unsigned char m_buffer[SERIAL_BUFFER];
+    unsigned char m_head;                       // next byte to read
+    unsigned char m_tail;                       // end of bytes in buffer
+
+public:
+    HardwareSerial();
+    void attach(int fd);
+    void begin(unsigned long baud);
+    void end();
+    virtual int available();
+    virtual int read();
+    virtual int peek();
+    virtual void flush();
+    virtual size_t write(uint8_t c);
+    using Print::write;
+    operator bool();
+};
+
+extern HardwareSerial Serial;
+
+#endif
@@ -0,0 +1,114 @@
+// Print class of the Arduino API, for building the library on Linux.
+// Distributed under MIT License, see license.txt for details.
+
+#include <string.h>
+#include "Print.h"
+
+size_t Print::write(const uint8_t* buffer, size_t size)
+{
+    size_t n = 0;
+
+    while (size--) {
+        n += write(*buffer++);
+    }
+
+    return n;
+}
+
+size_t Print::write(const char* str)
+{
+    return write((const uint8_t*)str, strlen(str));
+}
+
+size_t Print::printNumber(unsigned long n, uint8_t base)
+{
+    char digits[8 * sizeof(long) + 1];          // enough for base 2
+    char* p = &digits[sizeof(digits) - 1];
+
+    *p = 0;
+    do {
+        char d = n % base;
+        *--p = d < 10 ? '0' + d : 'A' + d - 10;
+        n /= base;
+    } while (n);
+
+    return write(p);
+}
+
+size_t Print::print(const char* str)
+{
+    return write(str);
+}
+
+size_t Print::print(char c)
+{
+    return write((uint8_t)c);
+}
+
+size_t Print::print(unsigned char n, int base)
+{
+    return printNumber(n, base);
+}
+
+size_t Print::print(int n, int base)
+{
+    return print((long)n, base);
+}
+
+size_t Print::print(unsigned int n, int base)
+{
+    return printNumber(n, base);
+}
+
+size_t Print::print(long n, int base)
+{
+    if (n < 0 && base == DEC) {                 // sign only for decimal numbers
+        return write('-') + printNumber(-(unsigned long)n, base);
+    }
+    return printNumber(n, base);
+}
+
+size_t Print::print(unsigned long n, int base)
+{
+    return printNumber(n, base);
+}
+
+size_t Print::println()
+{
+    return write("\r\n");
+}
+
+size_t Print::println(const char* str)
+{
+    return print(str) + println();
+}
+
+size_t Print::println(char c)
+{
+    return print(c) + println();
+}
+
+size_t Print::println(unsigned char n, int base)
+{
+    return print(n, base) + println();
+}
+
+size_t Print::println(int n, int base)
+{
+    return print(n, base) + println();
+}
+
+size_t Print::println(unsigned int n, int base)
+{
+    return print(n, base) + println();
+}
+
+size_t Print::println(long n, int base)
+{
+    return print(n, base) + println();
+}
+
+size_t Print::println(unsigned long n, int base)
+{
+    return print(n, base) + println();
+}
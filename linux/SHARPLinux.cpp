@@ -0,0 +1,498 @@
+// Linux backend for SHARPMemLCDTxt, drives the display with spidev and GPIO character devices.
+// Distributed under MIT License, see license.txt for details.
+
+#include <Arduino.h>
+#include <SPI.h>
+#include "SHARPLinux.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <sys/timerfd.h>
+#include <linux/gpio.h>
+#include <linux/spi/spidev.h>
+
+#define BURST_MAX 65536                         // size of buffer, spidev may allow less per ioctl
+#define SPIFILE_MAX 0x7fff                      // bytes per record in file of SPI device
+#define SPIFILE_CONTINUED 0x8000                // flag in length of record, burst continues in next record
+#define PINS SHARPLINUX_PINS
+
+SHARPLinuxClass SHARPLinux;
+SPIClass SPI;
+
+static __thread SHARPLinuxClass* selected;      // bus of calling thread, 0 for SHARPLinux
+
+static struct timespec start;                   // time of first begin, shared by all buses
+static pthread_once_t started = PTHREAD_ONCE_INIT;
+static char simulated;                          // clock only advances by waiting, see simulateTime
+static unsigned long long simulatedTime;
+
+// lookup table to reverse bit order of a byte
+#define R2(n) n, n + 2*64, n + 1*64, n + 3*64
+#define R4(n) R2(n), R2(n + 2*16), R2(n + 1*16), R2(n + 3*16)
+#define R6(n) R4(n), R4(n + 2*4), R4(n + 1*4), R4(n + 3*4)
+
+static const unsigned char bitrev[256] = {
+    R6(0), R6(2), R6(1), R6(3)
+};
+
+static SHARPLinuxClass* bus()
+{
+    return selected ? selected : &SHARPLinux;
+}
+
+static void startClock()
+{
+    clock_gettime(CLOCK_MONOTONIC, &start);
+}
+
+// time since first begin in microseconds
+static unsigned long long now()
+{
+    struct timespec t;
+
+    if (simulated) {                            // each read takes a microsecond, so busy waits end
+        return __sync_add_and_fetch(&simulatedTime, 1);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (t.tv_sec - start.tv_sec) * 1000000ULL + t.tv_nsec / 1000 - start.tv_nsec / 1000;
+}
+
+// append record to file of SPI device, length 0 marks a pulse on EXTCOMIN
+// keep marks the burst as continued by the next record
+void SHARPLinuxClass::record(const unsigned char* data, unsigned int length, char keep)
+{
+    unsigned char header[6];
+    unsigned long time = now() / 1000;
+    unsigned int flags = keep ? SPIFILE_CONTINUED : 0;
+
+    header[0] = time;
+    header[1] = time >> 8;
+    header[2] = time >> 16;
+    header[3] = time >> 24;
+    header[4] = length | flags;
+    header[5] = (length | flags) >> 8;
+
+    if (write(m_spiFd, header, 6) != 6 || (length && write(m_spiFd, data, length) != (ssize_t)length)) {
+        perror("SHARPLinux: write");
+    }
+
+    if (length) {                               // take as long as the bytes would take on the bus
+        delayMicroseconds(length * 8000000ULL / m_spiSpeed);
+    }
+}
+
+// send buffered bytes in one message per spiMax bytes
+// keep leaves chip select of spidev active, as following bytes belong to the same burst
+void SHARPLinuxClass::flush(char keep)
+{
+    unsigned int sent = 0;
+
+    pthread_mutex_lock(&m_lock);
+
+    while (sent < m_burstLength) {
+        unsigned int n = m_burstLength - sent;
+
+        if (m_spiFile) {
+            if (n > SPIFILE_MAX) {
+                n = SPIFILE_MAX;
+            }
+            record(m_burst + sent, n, keep || sent + n < m_burstLength);
+        } else {
+            if (n > m_spiMax) {
+                n = m_spiMax;
+            }
+
+            struct spi_ioc_transfer t;
+            memset(&t, 0, sizeof(t));
+            t.tx_buf = (unsigned long)(m_burst + sent);
+            t.len = n;
+            t.speed_hz = m_spiSpeed;
+            t.bits_per_word = 8;
+            t.cs_change = keep || sent + n < m_burstLength; // on last transfer, keeps chip select active
+
+            if (ioctl(m_spiFd, SPI_IOC_MESSAGE(1), &t) < 0) {
+                perror("SHARPLinux: SPI_IOC_MESSAGE");
+            }
+        }
+
+        messages++;
+        sent += n;
+    }
+
+    if (m_burstLength) {
+        bytes += m_burstLength;
+        bursts++;
+        m_fileBursts += m_spiFile;
+        m_burstLength = 0;
+    }
+
+    pthread_mutex_unlock(&m_lock);
+}
+
+void SHARPLinuxClass::setLine(unsigned char pin, unsigned char value)
+{
+    m_lineValue[pin] = value;
+
+    if (m_lineFd[pin] <= 0) return;             // simulated GPIO
+    if (m_chipFile) {
+        logLine("set", pin, value ? 1 : 0);
+        return;
+    }
+
+    struct gpio_v2_line_values v;
+    v.bits = value ? 1 : 0;
+    v.mask = 1;
+    if (ioctl(m_lineFd[pin], GPIO_V2_LINE_SET_VALUES_IOCTL, &v) < 0) {
+        perror("SHARPLinux: GPIO_V2_LINE_SET_VALUES_IOCTL");
+    }
+}
+
+// append event of line to file of GPIO chip, with value unless it is -1
+void SHARPLinuxClass::logLine(const char* event, unsigned char pin, int value)
+{
+    char text[64];
+    int n = snprintf(text, sizeof(text), "%lu %s %u", m_fileBursts, event, pin);
+
+    if (value >= 0) {
+        n += snprintf(text + n, sizeof(text) - n, " %d", value);
+    }
+    text[n++] = '\n';
+    if (write(m_chipFd, text, n) != n) {        // one write per line, so buses sharing the file don't mix lines
+        perror("SHARPLinux: write");
+    }
+}
+
+// short high pulse on EXTCOMIN
+void SHARPLinuxClass::pulse()
+{
+    pthread_mutex_lock(&m_lock);
+    setLine(m_vcomPin, HIGH);
+    delayMicroseconds(1);
+    setLine(m_vcomPin, LOW);
+    if (m_spiFile) {
+        record(0, 0, 0);
+    }
+    pulses++;
+    pthread_mutex_unlock(&m_lock);
+}
+
+void* SHARPLinuxClass::vcomTask(void* bus)
+{
+    SHARPLinuxClass* self = (SHARPLinuxClass*)bus;
+    unsigned long long expirations;
+
+    while (read(self->m_vcomTimer, &expirations, sizeof(expirations)) == sizeof(expirations)) {
+        int state;
+        pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &state);    // don't stop while holding lock
+        self->pulse();
+        pthread_setcancelstate(state, 0);
+    }
+
+    return 0;
+}
+
+SHARPLinuxClass::SHARPLinuxClass()
+    : m_spiFd(-1), m_spiFile(0), m_spiSpeed(0), m_spiMax(4096), m_spiOrder(MSBFIRST), m_burst(0),
+      m_burstLength(0), m_csHigh(0), m_spiNoCS(0), m_chipFd(-1), m_chipFile(0), m_fileBursts(0), m_vcomPin(-1), m_vcomTimer(-1),
+      messages(0), bursts(0), bytes(0), pulses(0)
+{
+    memset(m_lineFd, 0, sizeof(m_lineFd));
+    memset(m_lineValue, 0, sizeof(m_lineValue));
+    pthread_mutex_init(&m_lock, 0);
+}
+
+SHARPLinuxClass::~SHARPLinuxClass()
+{
+    delete[] m_burst;
+    pthread_mutex_destroy(&m_lock);
+}
+
+// open SPI device and GPIO chip, call before begin of the display
+// speed is the SPI clock in Hz, gpiochip can be 0 to simulate pins
+// if the controller can't drive chip select active high, the kernel doesn't drive it at all and SCS
+// must be on a line of gpiochip, without gpiochip begin fails with EINVAL
+// returns 0 on success, -1 with errno set otherwise
+int SHARPLinuxClass::begin(const char* spidev, unsigned long speed, const char* gpiochip)
+{
+    struct stat st;
+
+    pthread_once(&started, startClock);
+    m_spiSpeed = speed;
+    m_spiMax = 4096;
+    if (!m_burst) {
+        m_burst = new unsigned char[BURST_MAX];
+    }
+
+    if (stat(spidev, &st) == 0 && S_ISCHR(st.st_mode)) {
+        m_spiFile = 0;
+        m_spiFd = open(spidev, O_RDWR);
+        if (m_spiFd < 0) return -1;
+
+        unsigned char mode = SPI_MODE_0 | SPI_CS_HIGH;  // display latches data on rising edge of SCLK
+        unsigned char bits = 8;
+        unsigned int hz = speed;
+        m_spiNoCS = 0;
+        if (ioctl(m_spiFd, SPI_IOC_WR_MODE, &mode) < 0) {
+            mode = SPI_MODE_0 | SPI_NO_CS;      // active low chip select would invert SCS, it must be on GPIO
+            if (!gpiochip || ioctl(m_spiFd, SPI_IOC_WR_MODE, &mode) < 0) {
+                close(m_spiFd);
+                m_spiFd = -1;
+                errno = EINVAL;
+                return -1;
+            }
+            m_spiNoCS = 1;
+        }
+        ioctl(m_spiFd, SPI_IOC_WR_BITS_PER_WORD, &bits);
+        ioctl(m_spiFd, SPI_IOC_WR_MAX_SPEED_HZ, &hz);
+
+        FILE* f = fopen("/sys/module/spidev/parameters/bufsiz", "r");
+        if (f) {
+            if (fscanf(f, "%u", &m_spiMax) != 1 || m_spiMax == 0) {
+                m_spiMax = 4096;
+            }
+            fclose(f);
+        }
+        if (m_spiMax > BURST_MAX) {
+            m_spiMax = BURST_MAX;
+        }
+    } else {
+        m_spiFile = 1;
+        m_spiFd = open(spidev, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (m_spiFd < 0) return -1;
+
+        unsigned char header[10] = { 0xff, 0xff, 0xff, 0xff, 4, 0 };    // record of SPI clock at time 0xffffffff
+        header[6] = speed;
+        header[7] = speed >> 8;
+        header[8] = speed >> 16;
+        header[9] = speed >> 24;
+        if (write(m_spiFd, header, 10) != 10) {
+            perror("SHARPLinux: write");
+        }
+    }
+
+    m_fileBursts = 0;
+
+    if (gpiochip) {
+        m_chipFile = !(stat(gpiochip, &st) == 0 && S_ISCHR(st.st_mode));
+        m_chipFd = m_chipFile ? open(gpiochip, O_WRONLY | O_CREAT | O_APPEND, 0644) : open(gpiochip, O_RDWR);
+        if (m_chipFd < 0) return -1;
+    }
+
+    return 0;
+}
+
+void SHARPLinuxClass::end()
+{
+    flush(0);
+
+    if (m_vcomTimer >= 0) {
+        pthread_cancel(m_vcomThread);
+        pthread_join(m_vcomThread, 0);
+        close(m_vcomTimer);
+        m_vcomTimer = -1;
+    }
+    m_vcomPin = -1;
+
+    for (int i = 0; i < PINS; i++) {
+        if (m_lineFd[i] > 0) {
+            if (m_chipFile) {
+                logLine("release", i);
+            } else {
+                close(m_lineFd[i]);
+            }
+            m_lineFd[i] = 0;
+        }
+    }
+    if (m_chipFd >= 0) {
+        close(m_chipFd);
+        m_chipFd = -1;
+    }
+    if (m_spiFd >= 0) {
+        close(m_spiFd);
+        m_spiFd = -1;
+    }
+}
+
+// pin is EXTCOMIN, pass the same pin to the display
+// if period is not 0, EXTCOMIN is pulsed every period milliseconds by a timer, independent of pulse()
+// of the display, which no longer controls the pin
+int SHARPLinuxClass::vcom(char pin, unsigned int period)
+{
+    if (pin <= 0 || pin == SPIDEV_CS) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    m_vcomPin = pin;
+
+    if (period == 0) return 0;
+
+    SHARPLinuxClass* previous = selected;       // request pin of this bus
+    selected = this;
+    pinMode(pin, OUTPUT);
+    selected = previous;
+
+    m_vcomTimer = timerfd_create(CLOCK_MONOTONIC, 0);
+    if (m_vcomTimer < 0) return -1;
+
+    struct itimerspec t;
+    t.it_interval.tv_sec = period / 1000;
+    t.it_interval.tv_nsec = (period % 1000) * 1000000L;
+    t.it_value = t.it_interval;
+    if (timerfd_settime(m_vcomTimer, 0, &t, 0) < 0 || pthread_create(&m_vcomThread, 0, vcomTask, this) != 0) {
+        close(m_vcomTimer);
+        m_vcomTimer = -1;
+        return -1;
+    }
+
+    return 0;
+}
+
+// SPI and pins used by the calling thread go to this bus
+void SHARPLinuxClass::select()
+{
+    selected = this;
+}
+
+// from now on, time only advances by delays, bursts written to files and reads of the clock
+void SHARPLinuxClass::simulateTime()
+{
+    simulated = 1;
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    SHARPLinuxClass* b = bus();
+
+    if (pin == SPIDEV_CS && b->m_spiNoCS) {
+        fprintf(stderr, "SHARPLinux: SPI controller has no active high chip select, SCS must be on GPIO\n");
+    }
+    if (pin >= PINS || pin == SPIDEV_CS || b->m_lineFd[pin] > 0 || b->m_chipFd < 0) return;
+
+    if (b->m_chipFile) {                        // simulated line, file stands in for its descriptor
+        b->logLine("request", pin);
+        b->m_lineFd[pin] = b->m_chipFd;
+        return;
+    }
+
+    struct gpio_v2_line_request req;
+    memset(&req, 0, sizeof(req));
+    req.offsets[0] = pin;
+    req.num_lines = 1;
+    req.config.flags = mode == OUTPUT ? GPIO_V2_LINE_FLAG_OUTPUT : GPIO_V2_LINE_FLAG_INPUT;
+    strcpy(req.consumer, "SHARPMemLCD");
+
+    if (ioctl(b->m_chipFd, GPIO_V2_GET_LINE_IOCTL, &req) < 0) {
+        perror("SHARPLinux: GPIO_V2_GET_LINE_IOCTL");
+        return;
+    }
+    b->m_lineFd[pin] = req.fd;
+}
+
+// bytes sent before must be on the wire before the pin changes
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+    SHARPLinuxClass* b = bus();
+
+    if (pin >= PINS) return;
+
+    if (pin == SPIDEV_CS) {                     // start or end of burst
+        if (!value) {
+            b->flush(0);
+        }
+        b->m_csHigh = value;
+        return;
+    }
+
+    if (pin == b->m_vcomPin) {                  // EXTCOMIN, whole pulse is sent when it starts
+        if (value && b->m_vcomTimer < 0) {      // ignored if pin is driven by timer
+            b->flush(b->m_csHigh);
+            b->pulse();
+        }
+        return;
+    }
+
+    b->flush(b->m_csHigh);
+    b->setLine(pin, value);
+}
+
+unsigned long millis()
+{
+    return now() / 1000;
+}
+
+unsigned long micros()
+{
+    return now();
+}
+
+void delay(unsigned long ms)
+{
+    struct timespec t;
+
+    if (simulated) {
+        __sync_add_and_fetch(&simulatedTime, ms * 1000ULL);
+        return;
+    }
+
+    t.tv_sec = ms / 1000;
+    t.tv_nsec = (ms % 1000) * 1000000L;
+    while (nanosleep(&t, &t) < 0 && errno == EINTR);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+    struct timespec t;
+
+    if (simulated) {
+        __sync_add_and_fetch(&simulatedTime, us);
+        return;
+    }
+
+    t.tv_sec = us / 1000000;
+    t.tv_nsec = (us % 1000000) * 1000L;
+    while (nanosleep(&t, &t) < 0 && errno == EINTR);
+}
+
+void SPIClass::begin()
+{
+}
+
+void SPIClass::end()
+{
+    bus()->flush(0);
+}
+
+// data is always sent MSB first, bytes are reversed for LSB first
+void SPIClass::setBitOrder(uint8_t order)
+{
+    bus()->m_spiOrder = order;
+}
+
+// SPI clock is set with SHARPLinux.begin
+void SPIClass::setClockDivider(uint8_t)
+{
+}
+
+void SPIClass::setDataMode(uint8_t)
+{
+}
+
+uint8_t SPIClass::transfer(uint8_t data)
+{
+    SHARPLinuxClass* b = bus();
+
+    if (b->m_burstLength == BURST_MAX) {        // keep chip select active, burst continues
+        b->flush(1);
+    }
+    b->m_burst[b->m_burstLength++] = b->m_spiOrder == LSBFIRST ? bitrev[data] : data;
+
+    return 0;                                   // display has no output
+}
@@ -0,0 +1,95 @@
+// Linux backend for SHARPMemLCDTxt, drives the display with spidev and GPIO character devices.
+// Distributed under MIT License, see license.txt for details.
+//
+// Pins passed to the display are line offsets of the GPIO chip, or SPIDEV_CS for the chip select of
+// spidev, which needs a controller that supports SPI_CS_HIGH. Bytes sent with SPI.transfer are
+// buffered while chip select is high and sent with one SPI_IOC_MESSAGE ioctl when it goes low, or
+// before any other pin changes. Data is always sent MSB first, bytes for LSB first are reversed.
+//
+// If the SPI device is not a character device, it is created as a file and each burst is appended
+// with a header of time in milliseconds (32 bit) and length (16 bit), little endian. A length of 0
+// is a pulse on EXTCOMIN. Bursts of more than 32767 bytes are split into several records, all but
+// the last with bit 15 of length set. The file starts with a record at time 0xffffffff that holds
+// the SPI clock in Hz (32 bit). Writing a burst takes as long as sending it at the given speed, so
+// timing matches a panel. tools/sharptrace.py --spi decodes such a file. Without GPIO chip, pins
+// only keep their value.
+//
+// Each SHARPLinuxClass object is one SPI bus with its own GPIO lines. SPI and pin functions act on
+// the bus selected by the calling thread, SHARPLinux unless select was called. A bus must only be
+// used by one thread at a time, several displays can share it with chip select on GPIO. Other
+// threads can render into a frame buffer with a display that has no pins (PIN_NONE), as none of
+// its calls reach a bus.
+//
+// If the GPIO chip is not a character device, it is opened as a file and lines are simulated. Each
+// request, change and release of a line is appended as a line of text: the number of bursts the
+// bus has written to its SPI file since begin, "request", "set" or "release", the pin, and for set
+// its value. Several buses can append to the same file, as they share a chip. tools/sharptrace.py
+// --gpio uses it to pick the bursts sent while a chip select on GPIO was high.
+//
+// After simulateTime, millis and micros no longer follow the system clock. Time only advances by
+// delays, by the time bursts take when written to a file and by a microsecond each time it is read,
+// so runs are reproducible and take no longer than the CPU needs. The tests in test/ use this.
+
+#ifndef __SHARPLINUX_H__
+#define __SHARPLINUX_H__
+
+#include <pthread.h>
+#include <stdint.h>
+
+#define SPIDEV_CS 127                           // pin number for chip select of spidev, driven active high
+#define PIN_NONE -1                             // pin number that is ignored
+#define SHARPLINUX_PINS 128
+
+class SHARPLinuxClass
+{
+    friend class SPIClass;
+    friend void pinMode(uint8_t pin, uint8_t mode);
+    friend void digitalWrite(uint8_t pin, uint8_t value);
+
+private:
+    int m_spiFd;
+    char m_spiFile;                             // SPI device is a file, bursts are appended
+    unsigned long m_spiSpeed;
+    unsigned int m_spiMax;                      // bytes per ioctl, bufsiz of spidev
+    unsigned char m_spiOrder;
+    unsigned char* m_burst;
+    unsigned int m_burstLength;
+    char m_csHigh;                              // SPIDEV_CS is high, kernel keeps chip select active
+    char m_spiNoCS;                             // kernel doesn't drive chip select, SPIDEV_CS can't be used
+
+    int m_chipFd;
+    char m_chipFile;                            // GPIO chip is a file, lines are simulated and logged
+    unsigned long m_fileBursts;                 // bursts written to file of SPI device since begin
+    int m_lineFd[SHARPLINUX_PINS];              // file descriptor of requested GPIO line, 0 if not requested
+    unsigned char m_lineValue[SHARPLINUX_PINS];
+
+    char m_vcomPin;                             // EXTCOMIN, -1 if not used
+    int m_vcomTimer;
+    pthread_t m_vcomThread;
+    pthread_mutex_t m_lock;
+
+    void record(const unsigned char* data, unsigned int length, char keep);
+    void flush(char keep);
+    void setLine(unsigned char pin, unsigned char value);
+    void logLine(const char* event, unsigned char pin, int value = -1);
+    void pulse();
+    static void* vcomTask(void* bus);
+
+public:
+    unsigned long messages;                     // ioctls or writes to file
+    unsigned long bursts;                       // transfers with chip select high
+    unsigned long bytes;                        // bytes sent over SPI
+    unsigned long pulses;                       // pulses on EXTCOMIN
+
+    SHARPLinuxClass();
+    ~SHARPLinuxClass();
+    int begin(const char* spidev, unsigned long speed = 1000000, const char* gpiochip = 0);
+    void end();
+    int vcom(char pin, unsigned int period = 0);
+    void select();
+    static void simulateTime();
+};
+
+extern SHARPLinuxClass SHARPLinux;
+
+#endif
@@ -0,0 +1,58 @@
+// Lock-free ring buffer between one producer and one consumer thread.
+// Distributed under MIT License, see license.txt for details.
+//
+// Slots are used in place. The producer gets a free slot with back, fills it and publishes it
+// with push. The consumer gets the oldest published slot with front and releases it with pop.
+// back and front return 0 instead of waiting when the ring is full or empty, the caller decides
+// how to wait. size must be a power of 2.
+
+#ifndef __SHARPRING_H__
+#define __SHARPRING_H__
+
+template <class T, unsigned int size>
+class SHARPRing
+{
+private:
+    T m_slots[size];
+    volatile unsigned int m_head;               // slots published, written by producer only
+    char m_pad[64];                             // keep head and tail in separate cache lines
+    volatile unsigned int m_tail;               // slots released, written by consumer only
+
+public:
+    SHARPRing() : m_head(0), m_tail(0)
+    {
+    }
+
+    T* back()
+    {
+        if (m_head - m_tail == size) return 0;
+        __sync_synchronize();                   // slot is written after consumer released it
+        return &m_slots[m_head & (size - 1)];
+    }
+
+    void push()
+    {
+        __sync_synchronize();                   // slot is complete before it is published
+        m_head = m_head + 1;
+    }
+
+    T* front()
+    {
+        if (m_head == m_tail) return 0;
+        __sync_synchronize();                   // slot is read after producer published it
+        return &m_slots[m_tail & (size - 1)];
+    }
+
+    void pop()
+    {
+        __sync_synchronize();                   // slot is read before it is released
+        m_tail = m_tail + 1;
+    }
+
+    unsigned int count()
+    {
+        return m_head - m_tail;
+    }
+};
+
+#endif
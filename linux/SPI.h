@@ -0,0 +1,25 @@
+// SPI of the Arduino API on Linux spidev, see SHARPLinux.h.
+// Distributed under MIT License, see license.txt for details.
+
+#ifndef __SPI_H__
+#define __SPI_H__
+
+#include <stdint.h>
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+class SPIClass
+{
+public:
+    void begin();
+    void end();
+    void setBitOrder(uint8_t order);
+    void setClockDivider(uint8_t divider);
+    void setDataMode(uint8_t mode);
+    uint8_t transfer(uint8_t data);
+};
+
+extern SPIClass SPI;
+
+#endif
@@ -0,0 +1,18 @@
+// Stream class of the Arduino API, for building sketches on Linux.
+// Distributed under MIT License, see license.txt for details.
+
+#ifndef __STREAM_H__
+#define __STREAM_H__
+
+#include "Print.h"
+
+class Stream : public Print
+{
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    virtual void flush() = 0;
+};
+
+#endif
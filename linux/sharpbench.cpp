@@ -0,0 +1,129 @@
+// Throughput benchmark of the Linux backend, counts SPI messages and bytes per frame.
+// Distributed under MIT License, see license.txt for details.
+//
+// usage: sharpbench [-n frames] [spidev [speed [gpiochip cs disp extcomin]]]
+//
+// Without spidev, bursts are written to sharpbench.spi, which can be decoded with
+// tools/sharptrace.py --spi. Pins are line offsets of gpiochip, or simulated if gpiochip is -.
+// cs can be 127 (SPIDEV_CS) for chip select of spidev. Without extcomin, VCOM is inverted by commands.
+//
+// For each workload prints per frame: SPI messages (ioctls, or writes to file), bursts with
+// chip select high, bytes on the wire and time. Sending byte by byte would take one message
+// per byte. VCOM is inverted every 20 ms, so the file passes sharptrace.py --check.
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "SHARPLinux.h"
+#include "SHARPMemLCDTxt.h"
+
+#define VCOM_PERIOD 20                          // ms between VCOM inversions, at least 16 for the panel
+
+static unsigned char frame[PIXELS_X*PIXELS_Y/8];
+static unsigned char image[PIXELS_X*PIXELS_Y/8];
+
+static void report(const char* name, int frames, unsigned long time)
+{
+    printf("%-8s %8.1f %8.1f %8.1f %10.1f\n", name,
+           (double)SHARPLinux.messages / frames, (double)SHARPLinux.bursts / frames,
+           (double)SHARPLinux.bytes / frames, (double)time / frames);
+    SHARPLinux.messages = 0;
+    SHARPLinux.bursts = 0;
+    SHARPLinux.bytes = 0;
+}
+
+int main(int argc, char** argv)
+{
+    int frames = 100;
+    int arg = 1;
+
+    if (argc > 2 && strcmp(argv[1], "-n") == 0) {
+        frames = atoi(argv[2]);
+        arg = 3;
+    }
+    if (frames < 1) {
+        fprintf(stderr, "usage: sharpbench [-n frames] [spidev [speed [gpiochip cs disp extcomin]]]\n");
+        return 2;
+    }
+
+    const char* spidev = argc > arg ? argv[arg] : "sharpbench.spi";
+    unsigned long speed = argc > arg + 1 ? strtoul(argv[arg + 1], 0, 0) : 1000000;
+    const char* gpiochip = argc > arg + 2 && strcmp(argv[arg + 2], "-") ? argv[arg + 2] : 0;
+    char pinCS = argc > arg + 3 ? atoi(argv[arg + 3]) : SPIDEV_CS;
+    char pinDISP = argc > arg + 4 ? atoi(argv[arg + 4]) : 1;
+    char pinVCOM = argc > arg + 5 ? atoi(argv[arg + 5]) : 0;
+
+    if (SHARPLinux.begin(spidev, speed, gpiochip) < 0) {
+        perror(spidev);
+        return 1;
+    }
+    if (pinVCOM) {
+        SHARPLinux.vcom(pinVCOM);
+    }
+
+    SHARPMemLCDTxt display(pinCS, pinDISP, pinVCOM);
+    display.begin();
+    display.clear();
+    display.on();
+
+    for (unsigned int i = 0; i < sizeof(image); i++) {
+        image[i] = (i / (PIXELS_X/8) + i) & 1 ? 0xaa : 0x55;
+    }
+
+    printf("%s at %lu Hz, %d frames\n", spidev, speed, frames);
+    printf("workload messages   bursts    bytes    us/frame\n");
+
+    SHARPLinux.messages = 0;
+    SHARPLinux.bursts = 0;
+    SHARPLinux.bytes = 0;
+
+    // full screen of text, one burst per line of text
+    unsigned long start = micros();
+    for (int f = 0; f < frames; f++) {
+        for (int line = 0; line + 8 <= PIXELS_Y; line += 8) {
+            display.printf(line, f & 1 ? DISP_INVERT : 0, "FRAME %d", f);
+        }
+    }
+    report("text", frames, micros() - start);
+
+    // full screen bitmap in one burst
+    start = micros();
+    for (int f = 0; f < frames; f++) {
+        display.bitmap(image, PIXELS_X, PIXELS_Y, 0, f & 1 ? DISP_INVERT : 0);
+    }
+    report("bitmap", frames, micros() - start);
+
+    // frame buffer, all lines changed
+    display.attach(frame);
+    start = micros();
+    for (int f = 0; f < frames; f++) {
+        memset(frame, f & 1 ? 0x00 : 0xff, sizeof(frame));
+        display.flush();
+    }
+    report("flush", frames, micros() - start);
+    display.attach(0);
+
+    // every line in its own burst
+    start = micros();
+    for (int f = 0; f < frames; f++) {
+        for (int line = 0; line < PIXELS_Y; line++) {
+            display.fill(line, 1, f & 1 ? 0x00 : 0xff);
+        }
+    }
+    report("lines", frames, micros() - start);
+
+    // VCOM inversion, paced as the panel allows, only the time of the inversion counts
+    unsigned long time = 0;
+    for (int f = 0; f < frames; f++) {
+        delay(VCOM_PERIOD);
+        start = micros();
+        display.pulse(1);
+        time += micros() - start;
+    }
+    report("vcom", frames, time);
+
+    display.off();
+    SHARPLinux.end();
+
+    return 0;
+}
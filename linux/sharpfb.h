@@ -0,0 +1,31 @@
+// Layout of the shared frame buffer file of sharpfbd, for clients in C or C++.
+// Distributed under MIT License, see license.txt for details.
+//
+// A client maps the file, writes lines of pixels and then sets the bit of each changed line in dirty.
+// sharpfbd clears the bits before it reads the lines, so a line written while it is sent is marked
+// again and sent with the next update. Updates are sent at most at the rate of sharpfbd, changes in
+// between are combined.
+
+#ifndef __SHARPFB_H__
+#define __SHARPFB_H__
+
+#include <stdint.h>
+
+#define SHARPFB_MAGIC 0x42464853                // "SHFB"
+#define SHARPFB_LINES 256                       // maximum number of lines
+
+struct SHARPFramebuffer
+{
+    uint32_t magic;
+    uint16_t width;                             // pixels
+    uint16_t height;
+    uint32_t frames;                            // incremented by sharpfbd after each update of the display
+    uint32_t reserved;
+    uint8_t dirty[SHARPFB_LINES/8];             // bit (line & 7) of byte line/8 is set for changed lines
+};
+
+// pixels follow the header, height lines of width/8 bytes, leftmost pixel in MSB, set bits are white
+#define SHARPFB_PIXELS(fb) ((uint8_t*)(fb) + sizeof(struct SHARPFramebuffer))
+#define SHARPFB_SIZE(width, height) (sizeof(struct SHARPFramebuffer) + (width)/8*(height))
+
+#endif
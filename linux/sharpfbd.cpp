@@ -0,0 +1,152 @@
+// Frame buffer daemon, sends lines that other processes changed in a shared file to the display.
+// Distributed under MIT License, see license.txt for details.
+//
+// usage: sharpfbd [-f file] [-r rate] [-d] [-n updates] [spidev [speed [gpiochip cs disp extcomin]]]
+//
+// Creates file (default /dev/shm/sharpfb) with the layout of sharpfb.h. At most rate times per
+// second (default 30), if any line is marked in dirty, the whole frame buffer is compared with a
+// shadow copy of the display and the lines that differ are sent in one burst. Marks only tell that
+// an update is due, a line that changed without mark is sent along. With -d, the frame buffer is
+// compared on every pass, for clients that don't mark lines. Without spidev, bursts are written
+// to sharpfbd.spi, pins are as for sharpbench. Stops on SIGINT or SIGTERM, or after -n updates,
+// and prints number of updates.
+
+#include <Arduino.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "SHARPLinux.h"
+#include "SHARPMemLCDTxt.h"
+#include "sharpfb.h"
+
+static volatile sig_atomic_t running = 1;
+
+static void stop(int)
+{
+    running = 0;
+}
+
+int main(int argc, char** argv)
+{
+    const char* path = "/dev/shm/sharpfb";
+    unsigned int rate = 30;
+    char diff = 0;
+    long limit = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "f:r:dn:")) != -1) {
+        switch (opt) {
+        case 'f':
+            path = optarg;
+            break;
+        case 'r':
+            rate = atoi(optarg);
+            break;
+        case 'd':
+            diff = 1;
+            break;
+        case 'n':
+            limit = atol(optarg);
+            break;
+        default:
+            rate = 0;
+        }
+    }
+    if (rate == 0 || limit < 0) {
+        fprintf(stderr, "usage: sharpfbd [-f file] [-r rate] [-d] [-n updates] [spidev [speed [gpiochip cs disp extcomin]]]\n");
+        return 2;
+    }
+
+    int arg = optind;
+    const char* spidev = argc > arg ? argv[arg] : "sharpfbd.spi";
+    unsigned long speed = argc > arg + 1 ? strtoul(argv[arg + 1], 0, 0) : 1000000;
+    const char* gpiochip = argc > arg + 2 && strcmp(argv[arg + 2], "-") ? argv[arg + 2] : 0;
+    char pinCS = argc > arg + 3 ? atoi(argv[arg + 3]) : SPIDEV_CS;
+    char pinDISP = argc > arg + 4 ? atoi(argv[arg + 4]) : 1;
+    char pinVCOM = argc > arg + 5 ? atoi(argv[arg + 5]) : 0;
+
+    // shared frame buffer, white until a client draws
+    size_t size = SHARPFB_SIZE(PIXELS_X, PIXELS_Y);
+    int fd = open(path, O_RDWR | O_CREAT, 0666);
+    if (fd < 0 || ftruncate(fd, size) < 0) {
+        perror(path);
+        return 1;
+    }
+    SHARPFramebuffer* fb = (SHARPFramebuffer*)mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (fb == MAP_FAILED) {
+        perror(path);
+        return 1;
+    }
+    unsigned char* pixels = SHARPFB_PIXELS(fb);
+    memset(fb, 0, sizeof(SHARPFramebuffer));
+    memset(pixels, 0xff, PIXELS_X*PIXELS_Y/8);
+    fb->width = PIXELS_X;
+    fb->height = PIXELS_Y;
+    __sync_synchronize();
+    fb->magic = SHARPFB_MAGIC;                  // clients wait for magic
+
+    if (SHARPLinux.begin(spidev, speed, gpiochip) < 0) {
+        perror(spidev);
+        return 1;
+    }
+    if (pinVCOM) {
+        SHARPLinux.vcom(pinVCOM, 500);          // VCOM keeps running while idle
+    }
+
+    static unsigned char shadow[PIXELS_X*PIXELS_Y/8];
+    SHARPMemLCDTxt display(pinCS, pinDISP, pinVCOM);
+    display.begin();
+    display.clear();
+    display.on();
+    memset(shadow, 0xff, sizeof(shadow));      // display is white after clear
+    display.attach(pixels);
+
+    signal(SIGINT, stop);
+    signal(SIGTERM, stop);
+
+    unsigned long period = 1000000 / rate;
+    unsigned long next = micros();
+    unsigned long updates = 0;
+
+    while (running) {
+        next += period;
+        long wait = next - micros();
+        if (wait > 0) {
+            delayMicroseconds(wait);
+        } else {
+            next = micros();                    // late, don't try to catch up
+        }
+
+        char dirty = diff;
+        for (int i = 0; i < PIXELS_Y/8; i++) {  // clear marks before reading lines
+            if (fb->dirty[i] && __sync_fetch_and_and(&fb->dirty[i], 0)) {
+                dirty = 1;
+            }
+        }
+
+        if (dirty) {
+            display.flush(shadow);              // whole frame buffer is compared, changed lines are sent
+            __sync_fetch_and_add(&fb->frames, 1);
+            updates++;
+            if (limit && updates >= (unsigned long)limit) {
+                running = 0;
+            }
+        } else {
+            display.pulse(0);                   // VCOM inversion by command while idle
+        }
+    }
+
+    printf("%lu updates, %lu bytes\n", updates, SHARPLinux.bytes);
+
+    display.attach(0);
+    display.off();
+    SHARPLinux.end();
+    munmap(fb, size);
+    close(fd);
+
+    return 0;
+}
@@ -0,0 +1,348 @@
+// Pipelined rendering, a render thread hands changed lines to a transport thread that sends them.
+// Distributed under MIT License, see license.txt for details.
+//
+// usage: sharppipe [-n frames] [-w text|dither] [-d frames] [-b lines] [spidev [speed [gpiochip cs disp extcomin]]]
+//
+// Runs the workload twice. Serially, each frame is rendered and then flushed by the same thread,
+// so render time and bus time add up. Pipelined, the render thread renders into its own frame
+// buffer and queues the lines that changed in a lock-free ring (SHARPRing.h), while the main
+// thread collects them in a second frame buffer and flushes it when a frame is complete, or
+// every -b lines. When the ring is full, or the render thread is -d frames (default 2) ahead of
+// the display, it waits for the transport. More frames in flight absorb variations of render
+// time, at the cost of latency.
+//
+// Prints per frame: time, render and transport time, bus time of the bytes sent at the SPI speed,
+// and how often the render thread found the ring full and the transport found it empty. For the
+// pipeline, histograms of render time per frame, transport time per burst and latency from
+// rendering a line to the end of its burst follow, in buckets of powers of 2 microseconds.
+// Without spidev, bursts are written to sharppipe.spi, pins are as for sharpbench.
+
+#include <Arduino.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "SHARPLinux.h"
+#include "SHARPMemLCDTxt.h"
+#include "SHARPMemLCDDither.h"
+#include "SHARPRing.h"
+
+#define PIPE_SLOTS 256                          // lines in ring, a few frames
+#define LINE_FRAME -1                           // slot marks end of frame
+#define LINE_STOP -2                            // slot marks end of workload
+#define BUCKETS 20
+
+struct PipeLine {
+    unsigned long time;                         // micros when line was rendered
+    int line;
+    unsigned char data[PIXELS_X/8];
+};
+
+struct Histogram {
+    unsigned long count[BUCKETS];               // bucket i counts times below 2^(i+1) microseconds
+};
+
+struct Stats {
+    unsigned long render;                       // microseconds spent in each stage
+    unsigned long transport;
+    unsigned long full;                         // waits of render thread for the transport
+    unsigned long empty;                        // waits of transport for lines
+    Histogram renderTime;
+    Histogram transportTime;
+    Histogram latency;
+};
+
+static SHARPRing<PipeLine, PIPE_SLOTS> ring;
+static Stats stats;
+
+static unsigned char frame[PIXELS_X*PIXELS_Y/8];      // rendered frame
+static unsigned char previous[PIXELS_X*PIXELS_Y/8];   // frame as queued, to find changed lines
+static unsigned char wire[PIXELS_X*PIXELS_Y/8];       // lines received by transport
+static unsigned char shadow[PIXELS_X*PIXELS_Y/8];     // content of display
+
+static int frames = 100;
+static char workload = 0;
+static int batch = 0;
+static int depth = 2;
+static volatile int sent;                       // frames sent by transport
+
+static SHARPMemLCDDither dither;
+static unsigned char gray[PIXELS_X];
+
+static void add(Histogram& h, unsigned long us)
+{
+    int i = 0;
+    while (i < BUCKETS - 1 && us >= (2UL << i)) {
+        i++;
+    }
+    h.count[i]++;
+}
+
+static void print(const char* name, const Histogram& h)
+{
+    printf("%-10s", name);
+    for (int i = 0; i < BUCKETS; i++) {
+        if (h.count[i]) {
+            printf(i < BUCKETS - 1 ? " <%lu:%lu" : " >=%lu:%lu", i < BUCKETS - 1 ? 2UL << i : 1UL << i, h.count[i]);
+        }
+    }
+    printf("\n");
+}
+
+// give the other thread time, yielding first as most waits are short
+static void wait(int& spins)
+{
+    if (spins++ < 100) {
+        sched_yield();
+    } else {
+        delayMicroseconds(50);
+    }
+}
+
+// every line changes in each frame
+static void render(SHARPMemLCDTxt& display, int f)
+{
+    if (workload == 0) {
+        for (int line = 0; line + 8 <= PIXELS_Y; line += 8) {
+            display.printf(line, (f + line/8) & 1 ? DISP_INVERT : 0, "FRAME %d", f);
+        }
+    } else {
+        dither.begin(PIXELS_X);                 // moving diagonal gradient
+        for (int y = 0; y < PIXELS_Y; y++) {
+            for (int x = 0; x < PIXELS_X; x++) {
+                gray[x] = (x + y) * 255 / (PIXELS_X + PIXELS_Y) + f * 8;
+            }
+            dither.draw(display, gray, y);
+        }
+    }
+}
+
+// backpressure, render thread waits while transport is behind
+static void queue(int line, const unsigned char* data, unsigned long time)
+{
+    PipeLine* slot;
+    int spins = 0;
+
+    while ((slot = ring.back()) == 0) {
+        if (spins == 0) {
+            stats.full++;
+        }
+        wait(spins);
+    }
+
+    slot->time = time;
+    slot->line = line;
+    if (data) {
+        memcpy(slot->data, data, PIXELS_X/8);
+    }
+    ring.push();
+}
+
+static void* renderTask(void*)
+{
+    SHARPMemLCDTxt display(PIN_NONE, PIN_NONE, PIN_NONE);     // never sends, only renders into frame
+
+    display.attach(frame);
+    display.clear();
+    memset(previous, 0xff, sizeof(previous));
+
+    for (int f = 0; f < frames; f++) {
+        int spins = 0;
+        while (f - sent >= depth) {
+            if (spins == 0) {
+                stats.full++;
+            }
+            wait(spins);
+        }
+
+        unsigned long start = micros();
+        render(display, f);
+        unsigned long time = micros();
+        stats.render += time - start;
+        add(stats.renderTime, time - start);
+
+        for (int line = 0; line < PIXELS_Y; line++) {
+            unsigned char* data = frame + line*(PIXELS_X/8);
+            unsigned char* p = previous + line*(PIXELS_X/8);
+            if (memcmp(data, p, PIXELS_X/8)) {
+                memcpy(p, data, PIXELS_X/8);
+                queue(line, data, time);
+            }
+        }
+        queue(LINE_FRAME, 0, time);
+    }
+    queue(LINE_STOP, 0, micros());
+
+    return 0;
+}
+
+// send lines collected in wire, queued holds the time each line was rendered
+static void send(SHARPMemLCDTxt& display, const unsigned long* queued, int lines)
+{
+    unsigned long start = micros();
+    display.flush(shadow);                      // one burst of changed lines
+    unsigned long end = micros();
+
+    stats.transport += end - start;
+    add(stats.transportTime, end - start);
+    for (int i = 0; i < lines; i++) {
+        add(stats.latency, end - queued[i]);
+    }
+}
+
+static void transport(SHARPMemLCDTxt& display)
+{
+    unsigned long queued[PIXELS_Y];
+    int lines = 0;
+    int line;
+
+    display.attach(wire);
+
+    do {
+        PipeLine* slot;
+        int spins = 0;
+
+        while ((slot = ring.front()) == 0) {
+            if (spins == 0) {
+                stats.empty++;
+            }
+            display.pulse(0);                   // VCOM inversion by command while waiting
+            wait(spins);
+        }
+
+        line = slot->line;
+        if (line >= 0) {
+            memcpy(wire + line*(PIXELS_X/8), slot->data, PIXELS_X/8);
+            queued[lines++] = slot->time;
+        }
+        ring.pop();
+
+        if (line < 0 || lines == PIXELS_Y || (batch && lines >= batch)) {
+            if (lines) {
+                send(display, queued, lines);
+            }
+            lines = 0;
+        }
+        if (line == LINE_FRAME) {
+            sent = sent + 1;
+        }
+    } while (line != LINE_STOP);
+}
+
+static void serial(SHARPMemLCDTxt& display)
+{
+    display.attach(frame);
+    display.clear();
+
+    for (int f = 0; f < frames; f++) {
+        unsigned long start = micros();
+        render(display, f);
+        unsigned long time = micros();
+        display.flush(shadow);
+        unsigned long end = micros();
+
+        stats.render += time - start;
+        stats.transport += end - time;
+        add(stats.renderTime, time - start);
+        add(stats.transportTime, end - time);
+        add(stats.latency, end - time);
+    }
+}
+
+static void report(const char* name, unsigned long time, unsigned long speed)
+{
+    printf("%-10s %9.1f %9.1f %9.1f %9.1f %7lu %7lu\n", name,
+           (double)time / frames, (double)stats.render / frames, (double)stats.transport / frames,
+           SHARPLinux.bytes * 8e6 / speed / frames, stats.full, stats.empty);
+}
+
+// display is blank and shadow matches it
+static void reset(SHARPMemLCDTxt& display)
+{
+    display.attach(0);
+    display.clear();
+    memset(shadow, 0xff, sizeof(shadow));
+    memset(wire, 0xff, sizeof(wire));
+    memset(&stats, 0, sizeof(stats));
+    SHARPLinux.bytes = 0;
+}
+
+int main(int argc, char** argv)
+{
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:w:d:b:")) != -1) {
+        switch (opt) {
+        case 'n':
+            frames = atoi(optarg);
+            break;
+        case 'w':
+            workload = strcmp(optarg, "text") == 0 ? 0 : strcmp(optarg, "dither") == 0 ? 1 : -1;
+            break;
+        case 'd':
+            depth = atoi(optarg);
+            break;
+        case 'b':
+            batch = atoi(optarg);
+            break;
+        default:
+            frames = 0;
+        }
+    }
+    if (frames < 1 || workload < 0 || depth < 1 || batch < 0) {
+        fprintf(stderr, "usage: sharppipe [-n frames] [-w text|dither] [-d frames] [-b lines] [spidev [speed [gpiochip cs disp extcomin]]]\n");
+        return 2;
+    }
+
+    int arg = optind;
+    const char* spidev = argc > arg ? argv[arg] : "sharppipe.spi";
+    unsigned long speed = argc > arg + 1 ? strtoul(argv[arg + 1], 0, 0) : 1000000;
+    const char* gpiochip = argc > arg + 2 && strcmp(argv[arg + 2], "-") ? argv[arg + 2] : 0;
+    char pinCS = argc > arg + 3 ? atoi(argv[arg + 3]) : SPIDEV_CS;
+    char pinDISP = argc > arg + 4 ? atoi(argv[arg + 4]) : 1;
+    char pinVCOM = argc > arg + 5 ? atoi(argv[arg + 5]) : 0;
+
+    if (SHARPLinux.begin(spidev, speed, gpiochip) < 0) {
+        perror(spidev);
+        return 1;
+    }
+    if (pinVCOM) {
+        SHARPLinux.vcom(pinVCOM);
+    }
+
+    SHARPMemLCDTxt display(pinCS, pinDISP, pinVCOM);
+    display.begin();
+    display.on();
+
+    printf("%s at %lu Hz, %d frames of %s\n", spidev, speed, frames, workload ? "dither" : "text");
+    printf("mode        us/frame    render transport       bus    full   empty\n");
+
+    reset(display);
+    unsigned long start = micros();
+    serial(display);
+    report("serial", micros() - start, speed);
+
+    reset(display);
+    sent = 0;
+    start = micros();
+    pthread_t thread;
+    if (pthread_create(&thread, 0, renderTask, 0) != 0) {
+        perror("pthread_create");
+        return 1;
+    }
+    transport(display);
+    pthread_join(thread, 0);
+    report("pipelined", micros() - start, speed);
+
+    printf("\nus         histogram of pipeline\n");
+    print("render", stats.renderTime);
+    print("transport", stats.transportTime);
+    print("latency", stats.latency);
+
+    display.attach(0);
+    display.off();
+    SHARPLinux.end();
+
+    return 0;
+}
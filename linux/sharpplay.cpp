@@ -0,0 +1,151 @@
+// Player for animation files of tools/sharpanim.py, mapped into memory instead of compiled in.
+// Distributed under MIT License, see license.txt for details.
+//
+// usage: sharpplay [-l] [-y line] [-t] animation [spidev [speed [gpiochip cs disp extcomin]]]
+//
+// animation is a binary file written by sharpanim.py -b. It is mapped read only and checked
+// before playing: header as described in SHARPMemLCDAnim.h, bytes per line matching the display,
+// and every frame complete within the file, so a truncated file is rejected instead of read
+// beyond its end. Frames are then decoded by SHARPMemLCDAnim straight from the mapping, at line
+// -y (default 0). With -l, the animation loops until SIGINT or SIGTERM. With -t, time is
+// simulated as in the tests, so periods take no time. Without spidev, bursts are written to
+// sharpplay.spi, pins are as for sharpbench.
+
+#include <Arduino.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "SHARPLinux.h"
+#include "SHARPMemLCDTxt.h"
+#include "SHARPMemLCDAnim.h"
+
+static volatile sig_atomic_t running = 1;
+
+static void stop(int)
+{
+    running = 0;
+}
+
+// returns number of frames, or -1 if size bytes of data are not a complete animation for this display
+static long validate(const unsigned char* data, size_t size)
+{
+    if (size < 8 || data[0] != 'S' || data[1] != 'A' || data[2] != PIXELS_X/8) return -1;
+
+    int height = data[3];
+    long frames = data[4] | (data[5] << 8);
+    size_t pos = 8;
+
+    for (long f = 0; f < frames; f++) {
+        const unsigned char* lines = data + pos;    // bitmap of changed lines
+        pos += (height + 7) / 8;
+        if (pos > size) return -1;
+
+        for (int y = 0; y < height; y++) {
+            if (!(lines[y >> 3] & (1 << (y & 7)))) continue;
+
+            const unsigned char* bytes = data + pos;    // bitmap of changed bytes, then the bytes
+            pos += (PIXELS_X/8 + 7) / 8;
+            if (pos > size) return -1;
+            for (int j = 0; j < PIXELS_X/8; j++) {
+                if (bytes[j >> 3] & (1 << (j & 7))) {
+                    pos++;
+                }
+            }
+            if (pos > size) return -1;
+        }
+    }
+
+    return frames;
+}
+
+int main(int argc, char** argv)
+{
+    char loop = 0;
+    int line = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "ly:t")) != -1) {
+        switch (opt) {
+        case 'l':
+            loop = 1;
+            break;
+        case 'y':
+            line = atoi(optarg);
+            break;
+        case 't':
+            SHARPLinux.simulateTime();
+            break;
+        default:
+            line = -1;
+        }
+    }
+    if (line < 0 || optind >= argc) {
+        fprintf(stderr, "usage: sharpplay [-l] [-y line] [-t] animation [spidev [speed [gpiochip cs disp extcomin]]]\n");
+        return 2;
+    }
+
+    int arg = optind;
+    const char* path = argv[arg++];
+    const char* spidev = argc > arg ? argv[arg] : "sharpplay.spi";
+    unsigned long speed = argc > arg + 1 ? strtoul(argv[arg + 1], 0, 0) : 1000000;
+    const char* gpiochip = argc > arg + 2 && strcmp(argv[arg + 2], "-") ? argv[arg + 2] : 0;
+    char pinCS = argc > arg + 3 ? atoi(argv[arg + 3]) : SPIDEV_CS;
+    char pinDISP = argc > arg + 4 ? atoi(argv[arg + 4]) : 1;
+    char pinVCOM = argc > arg + 5 ? atoi(argv[arg + 5]) : 0;
+
+    struct stat st;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0 || fstat(fd, &st) < 0) {
+        perror(path);
+        return 1;
+    }
+    size_t size = st.st_size;
+    const unsigned char* data = size ? (const unsigned char*)mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0) : 0;
+    if (data == MAP_FAILED) {
+        perror(path);
+        return 1;
+    }
+    long frames = data ? validate(data, size) : -1;
+    if (frames < 0) {
+        fprintf(stderr, "%s: not a complete animation %d pixels wide\n", path, PIXELS_X);
+        return 1;
+    }
+
+    if (SHARPLinux.begin(spidev, speed, gpiochip) < 0) {
+        perror(spidev);
+        return 1;
+    }
+    if (pinVCOM) {
+        SHARPLinux.vcom(pinVCOM);
+    }
+
+    SHARPMemLCDTxt display(pinCS, pinDISP, pinVCOM);
+    display.begin();
+    display.clear();
+    display.on();
+
+    unsigned char* shadow = (unsigned char*)malloc((PIXELS_X/8) * data[3] + 1);
+    SHARPMemLCDAnim anim(display);
+    anim.begin(data, shadow, line);
+
+    signal(SIGINT, stop);
+    signal(SIGTERM, stop);
+
+    while (running && anim.play(loop)) {
+        delay(1);
+    }
+
+    printf("%ld frames of %d lines, %lu bytes\n", frames, data[3], SHARPLinux.bytes);
+
+    display.off();
+    SHARPLinux.end();
+    free(shadow);
+    munmap((void*)data, size);
+    close(fd);
+
+    return 0;
+}
@@ -0,0 +1,419 @@
+// Video wall, shows one large canvas on a grid of panels driven in parallel over several SPI buses.
+// Distributed under MIT License, see license.txt for details.
+//
+// usage: sharpwall [-n frames] [-w box|full] [-p panels] [-t workers] [-b buses] [-s speed]
+//                  [-g gpiochip] [-c cs] [-d disp] [spidev...]
+//
+// The canvas is split into one tile per panel, panels are placed in rows of a power of 2. Panel i
+// is on bus i % buses, with chip select on pin cs + i (default 2), so each panel has its own line.
+// With cs 127 (SPIDEV_CS), chip select of spidev is used, and each panel needs a bus of its own.
+// DISP of all panels is wired to pin disp (default 1), which is requested once, by panel 0 on
+// bus 0, as a line of the chip can only be requested once. Buses are the given spidev devices, -b
+// must then be their number if given, or files sharpwall0.spi ... (at most -b, default 4). Pins are
+// simulated without gpiochip. Files only hold chip select of spidev. With a file as gpiochip, the
+// backend logs line requests and changes to it, and sharptrace.py --gpio picks out the bursts of
+// one panel from the file of its bus.
+//
+// Each bus has a queue of tiles to send (SHARPRing.h), filled by the main thread. Worker w of the
+// pool serves the queues of buses w, w + workers, ..., as a bus sends one burst at a time. For
+// each tile, the worker copies the tile from the canvas into the frame buffer of its panel and
+// flushes it against a shadow copy, so only lines that changed on that panel are sent. Meanwhile,
+// the main thread renders the next frame into a second canvas. It waits before rendering into a
+// canvas that panels are still sending.
+//
+// The box workload moves a black square across the wall, so most tiles don't change. In full,
+// every line of every panel changes. Without -p and -t, all combinations of 1, 2, 4, 8 and 16
+// panels with 1, 2, 4 and 8 workers (up to the number of buses) are run. For each, prints time
+// per frame, speedup over one worker, bytes per frame and the time the busiest bus needs per
+// frame at the SPI speed, which is the lower bound.
+
+#include <Arduino.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "SHARPLinux.h"
+#include "SHARPMemLCDTxt.h"
+#include "SHARPRing.h"
+
+#define WALL_PANELS 16
+#define WALL_QUEUE 64                           // tiles in queue of a bus, a few frames of all its panels
+#define BOX 32                                  // size of square in box workload
+
+struct Panel {
+    SHARPMemLCDTxt* display;
+    SHARPLinuxClass* bus;
+    int x;                                      // position of tile in canvas, in bytes
+    int y;                                      // in lines
+    volatile int done;                          // frames sent
+    unsigned char frame[PIXELS_X*PIXELS_Y/8];
+    unsigned char shadow[PIXELS_X*PIXELS_Y/8];
+};
+
+struct WallJob {
+    int panel;                                  // -1 stops the worker serving the bus
+    int frame;
+};
+
+static SHARPLinuxClass buses[WALL_PANELS];
+static SHARPRing<WallJob, WALL_QUEUE> queues[WALL_PANELS];
+static Panel panels[WALL_PANELS];
+static unsigned char* canvas[2];                // frames are rendered alternately into each
+
+static int panelCount;
+static int busCount;
+static int workerCount;
+static int stride;                              // bytes per line of canvas
+static int width;                               // canvas size in pixels
+static int height;
+
+static int frames = 20;
+static char workload = 0;
+static unsigned long speed = 1000000;
+static const char* gpiochip = 0;
+static char pinCS = 2;
+static char pinDISP = 1;
+static const char* spidevs[WALL_PANELS];
+static int spidevCount;
+
+// give the other threads time, yielding first as most waits are short
+// returns 1 once the wait is long
+static char wait(int& spins)
+{
+    if (spins++ < 100) {
+        sched_yield();
+        return 0;
+    }
+    delayMicroseconds(50);
+    return 1;
+}
+
+// canvas is in display format, set bits are white
+static void render(unsigned char* c, int f)
+{
+    if (workload == 0) {                        // square bouncing diagonally across the wall
+        memset(c, 0xff, stride*height);
+
+        int x = f*4 % (2*(width - BOX));
+        int y = f*4 % (2*(height - BOX));
+        if (x >= width - BOX) {
+            x = 2*(width - BOX) - x;
+        }
+        if (y >= height - BOX) {
+            y = 2*(height - BOX) - y;
+        }
+
+        for (int j = y; j < y + BOX; j++) {
+            unsigned char* row = c + j*stride;
+            for (int i = x; i < x + BOX; i++) {
+                row[i >> 3] &= ~(0x80 >> (i & 7));
+            }
+        }
+    } else {                                    // checkerboard of 8x8 pixels, inverted each frame
+        for (int j = 0; j < height; j++) {
+            memset(c + j*stride, ((j >> 3) + f) & 1 ? 0x00 : 0xff, stride);
+            for (int i = 1; i < stride; i += 2) {
+                c[j*stride + i] = ~c[j*stride + i];
+            }
+        }
+    }
+}
+
+// copy tile of panel from canvas and send lines that changed
+static void send(const WallJob& job)
+{
+    Panel& p = panels[job.panel];
+    const unsigned char* c = canvas[job.frame & 1] + p.y*stride + p.x;
+
+    for (int line = 0; line < PIXELS_Y; line++) {
+        memcpy(p.frame + line*(PIXELS_X/8), c + line*stride, PIXELS_X/8);
+    }
+
+    p.bus->select();
+    p.display->flush(p.shadow);
+    p.done = job.frame + 1;
+}
+
+static void* workerTask(void* arg)
+{
+    int w = (int)(long)arg;
+    int running = 0;
+    int spins = 0;
+
+    for (int b = w; b < busCount; b += workerCount) {
+        running++;
+    }
+
+    while (running) {
+        char busy = 0;
+
+        for (int b = w; b < busCount; b += workerCount) {
+            WallJob* job = queues[b].front();
+            if (!job) continue;
+
+            if (job->panel < 0) {
+                running--;
+            } else {
+                send(*job);
+                busy = 1;
+            }
+            queues[b].pop();
+        }
+
+        if (busy) {
+            spins = 0;
+        } else if (wait(spins)) {               // idle, VCOM inversion by command
+            for (int i = 0; i < panelCount; i++) {
+                if (i % busCount % workerCount == w) {
+                    panels[i].bus->select();
+                    panels[i].display->pulse(0);
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+static void enqueue(int b, int panel, int frame)
+{
+    WallJob* job;
+    int spins = 0;
+
+    while ((job = queues[b].back()) == 0) {     // bus is behind
+        wait(spins);
+    }
+    job->panel = panel;
+    job->frame = frame;
+    queues[b].push();
+}
+
+static int setup(int count)
+{
+    int cols = 1;
+    while (cols*cols < count) {
+        cols <<= 1;
+    }
+
+    panelCount = count;
+    busCount = spidevCount ? spidevCount : busCount;
+    if (busCount > count) {
+        busCount = count;
+    }
+
+    if (pinCS == SPIDEV_CS && count > busCount) {
+        fprintf(stderr, "sharpwall: %d panels on %d buses need chip select on GPIO\n", count, busCount);
+        return -1;
+    }
+    if (pinCS != SPIDEV_CS && pinDISP >= pinCS && pinDISP < pinCS + count) {
+        fprintf(stderr, "sharpwall: DISP on pin %d is chip select of panel %d\n", pinDISP, pinDISP - pinCS);
+        return -1;
+    }
+    stride = cols*(PIXELS_X/8);
+    width = cols*PIXELS_X;
+    height = (count + cols - 1) / cols * PIXELS_Y;
+
+    for (int b = 0; b < busCount; b++) {
+        char name[32];
+        const char* spidev = spidevs[b];
+        if (!spidev) {
+            sprintf(name, "sharpwall%d.spi", b);
+            spidev = name;
+        }
+        if (buses[b].begin(spidev, speed, gpiochip) < 0) {
+            perror(spidev);
+            return -1;
+        }
+    }
+
+    for (int i = 0; i < count; i++) {
+        Panel& p = panels[i];
+        p.bus = &buses[i % busCount];
+        p.x = i % cols * (PIXELS_X/8);
+        p.y = i / cols * PIXELS_Y;
+        p.done = 0;
+        p.display = new SHARPMemLCDTxt(pinCS == SPIDEV_CS ? SPIDEV_CS : pinCS + i, i == 0 ? pinDISP : PIN_NONE, 0);
+
+        p.bus->select();
+        p.display->begin();
+        p.display->clear();
+        p.display->on();
+        p.display->attach(p.frame);
+        memset(p.shadow, 0xff, sizeof(p.shadow));   // display is white after clear
+    }
+
+    for (int k = 0; k < 2; k++) {
+        canvas[k] = new unsigned char[stride*height];
+    }
+
+    for (int b = 0; b < busCount; b++) {
+        buses[b].bytes = 0;
+    }
+
+    return 0;
+}
+
+static void teardown()
+{
+    for (int i = 0; i < panelCount; i++) {
+        panels[i].bus->select();
+        panels[i].display->attach(0);
+        panels[i].display->off();
+        delete panels[i].display;
+    }
+    for (int b = 0; b < busCount; b++) {
+        buses[b].end();
+    }
+    for (int k = 0; k < 2; k++) {
+        delete[] canvas[k];
+    }
+}
+
+// returns microseconds per frame, or 0 on error
+static double run(int count, int workers, int maxBuses, double base)
+{
+    busCount = maxBuses;
+    if (setup(count) < 0) return 0;
+
+    workerCount = workers < busCount ? workers : busCount;
+
+    unsigned long start = micros();
+
+    pthread_t threads[WALL_PANELS];
+    for (int w = 0; w < workerCount; w++) {
+        if (pthread_create(&threads[w], 0, workerTask, (void*)(long)w) != 0) {
+            perror("pthread_create");
+            exit(1);
+        }
+    }
+
+    for (int f = 0; f < frames; f++) {
+        for (int i = 0; i < count; i++) {       // canvas is free once all panels sent the frame before
+            int spins = 0;
+            while (panels[i].done < f - 1) {
+                wait(spins);
+            }
+        }
+
+        render(canvas[f & 1], f);
+
+        for (int i = 0; i < count; i++) {
+            enqueue(i % busCount, i, f);
+        }
+    }
+
+    for (int b = 0; b < busCount; b++) {
+        enqueue(b, -1, 0);
+    }
+    for (int w = 0; w < workerCount; w++) {
+        pthread_join(threads[w], 0);
+    }
+
+    double time = (double)(micros() - start) / frames;
+
+    unsigned long bytes = 0;
+    unsigned long busiest = 0;
+    for (int b = 0; b < busCount; b++) {
+        bytes += buses[b].bytes;
+        if (buses[b].bytes > busiest) {
+            busiest = buses[b].bytes;
+        }
+    }
+
+    printf("%6d %6d %7d %10.1f %8.2f %11.1f %10.1f\n", count, busCount, workerCount, time / 1000,
+           base ? base / time : 1.0, (double)bytes / frames, busiest * 8000.0 / speed / frames);
+
+    teardown();
+
+    return time;
+}
+
+int main(int argc, char** argv)
+{
+    int count = 0;
+    int workers = 0;
+    int maxBuses = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:w:p:t:b:s:g:c:d:")) != -1) {
+        switch (opt) {
+        case 'n':
+            frames = atoi(optarg);
+            break;
+        case 'w':
+            workload = strcmp(optarg, "box") == 0 ? 0 : strcmp(optarg, "full") == 0 ? 1 : -1;
+            break;
+        case 'p':
+            count = atoi(optarg);
+            break;
+        case 't':
+            workers = atoi(optarg);
+            break;
+        case 'b':
+            maxBuses = atoi(optarg) > 0 ? atoi(optarg) : -1;  // 0 is the default, not a valid count
+            break;
+        case 's':
+            speed = strtoul(optarg, 0, 0);
+            break;
+        case 'g':
+            gpiochip = optarg;
+            break;
+        case 'c':
+            pinCS = atoi(optarg);
+            break;
+        case 'd':
+            pinDISP = atoi(optarg);
+            break;
+        default:
+            frames = 0;
+        }
+    }
+    spidevCount = argc - optind;
+    if (frames < 1 || workload < 0 || count < 0 || count > WALL_PANELS || workers < 0 || workers > WALL_PANELS ||
+        maxBuses < 0 || maxBuses > WALL_PANELS || spidevCount > WALL_PANELS || speed == 0) {
+        fprintf(stderr, "usage: sharpwall [-n frames] [-w box|full] [-p panels] [-t workers] [-b buses] [-s speed]\n"
+                        "                 [-g gpiochip] [-c cs] [-d disp] [spidev...]\n");
+        return 2;
+    }
+    if (spidevCount && maxBuses && maxBuses != spidevCount) {
+        fprintf(stderr, "sharpwall: -b %d with %d spidev devices\n", maxBuses, spidevCount);
+        return 2;
+    }
+    if (!maxBuses) {
+        maxBuses = spidevCount ? spidevCount : 4;
+    }
+    for (int b = 0; b < spidevCount; b++) {
+        spidevs[b] = argv[optind + b];
+    }
+
+    static const int counts[] = { 1, 2, 4, 8, 16 };
+    static const int pools[] = { 1, 2, 4, 8 };
+
+    printf("%d frames of %s at %lu Hz\n", frames, workload ? "full" : "box", speed);
+    printf("panels  buses workers   ms/frame  speedup bytes/frame    bus ms\n");
+
+    for (int i = 0; i < 5; i++) {
+        int n = count ? count : counts[i];
+        int usable = spidevCount ? spidevCount : maxBuses;
+        if (usable > n) {
+            usable = n;
+        }
+
+        double base = 0;
+        for (int k = 0; k < 4; k++) {
+            int w = workers ? workers : pools[k];
+            if (!workers && w > usable) break;
+
+            double time = run(n, w, maxBuses, base);
+            if (time == 0) return 1;
+            if (!base) {
+                base = time;
+            }
+            if (workers) break;
+        }
+        if (count) break;
+    }
+
+    return 0;
+}
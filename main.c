@@ -7,7 +7,8 @@
 //  This code also works with the predecessor LS013B4DN02 and should work with any
 //  display of that series with compatible pinouts.
 //
-//  ACLK = n/a, MCLK = SMCLK = default DCO. Note that display specifies 1MHz max for SCLK
+//  ACLK = n/a, MCLK = SMCLK = default DCO (~1.1 MHz). Note that display specifies 1MHz max for SCLK,
+//  SPI runs at SMCLK/8. When raising MCLK, keep SMCLK/UCB0BR0 at or below 1 MHz.
 //
 //                MSP430G2553
 //             -----------------
@@ -36,8 +37,13 @@
 
 #include <msp430.h>				
 
+//#define SHARP_FONT_FIRST '0'			// only include characters from SHARP_FONT_FIRST to SHARP_FONT_LAST in font
+//#define SHARP_FONT_LAST ':'			// to save flash, default is SPACE to Z
+//#include "fontset.h"					// or only the characters used, generated by make fontset
 #include "font.h"
 
+//#define FONT_TABLES					// render text from font tables transformed by the compiler, uses 2.4 KB more flash
+
 #define _LED	BIT0					// LED1 used to verify VCOM state
 #define _SCLK	BIT5					// SPI clock
 #define _SDATA	BIT7					// SPI data (sent to display)
@@ -56,25 +62,99 @@
 #define DISP_WIDE 2						// double-width text
 #define DISP_HIGH 4						// double-height text
 
+//#define SHARP_TRACE 16					// record what is sent to display in sharpTrace, read with debugger
+//#define SHARP_TRACE_DATA				// record pixels of each line instead of a hash only
+
+#define TRACE_START 0x40				// trace flag, first line of transfer
+
+//#define PROFILE						// measure cycles of rendering at startup, read profileCycles with debugger
+										// or run make profile, see tools/sharpprofile.py
+
+#ifdef PROFILE							// index of measurements in profileCycles
+#define PROFILE_OVERHEAD 0				// cost of measurement, subtract from other results
+#define PROFILE_BYTE 1					// SPIWriteByte
+#define PROFILE_LINE 2					// SPIWriteLine with one line
+#define PROFILE_WIDE 3					// doubleWideAsm
+#define PROFILE_PRINT 4					// printSharp with 12 characters, 8 entries for options 0-7
+#define PROFILE_COUNT 12
+#endif
+
 unsigned char LineBuff[PIXELS_X/8];		// line buffer
 
 volatile unsigned char VCOM;			// current state of VCOM (0x04 or 0x00)
 
 volatile unsigned int timeMSec;			// clock milliseconds
-volatile unsigned char timeSecond;		// clock seconds
-volatile unsigned char timeMinute;		// clock minutes
+volatile unsigned char timeSecond;		// clock seconds, BCD
+volatile unsigned char timeMinute;		// clock minutes, BCD
 
 char TextBuff[9];						// buffer to build line of text
 
+#ifdef SHARP_TRACE
+typedef struct							// one command or line sent to display
+{
+	unsigned long time;					// milliseconds since start
+	unsigned char cmd;					// command byte as sent, plus TRACE_START
+	unsigned char line;					// line address as sent, 0 for commands without line
+	unsigned int hash;					// hash of line data
+#ifdef SHARP_TRACE_DATA
+	unsigned char data[PIXELS_X/8];		// line data as sent
+#endif
+} TraceRecord;
+
+struct									// ring buffer of records, decode with tools/sharptrace.py --binary
+{
+	unsigned int count;					// number of records since start
+	unsigned char next;					// index of next record
+	TraceRecord record[SHARP_TRACE];
+} sharpTrace;
+
+volatile unsigned long traceMSec;		// time for trace records
+
+void traceRecord(unsigned char cmd, unsigned char line, const unsigned char* data);
+#endif
+
+#ifdef PROFILE
+unsigned int profileCycles[PROFILE_COUNT];	// MCLK cycles of each measurement
+
+#define PROFILE_START()	(TA1R = 0)
+#define PROFILE_STOP(i)	(profileCycles[i] = TA1R)
+
+void profile(void);
+void profileDone(void);
+#endif
+
+#ifdef FONT_TABLES						// font in display format, set bits are white
+const unsigned char fontWire[FONT_SIZE + 1] = {
+#define FONT_ROW(b) FONT_INV(b),
+#include "fontrows.h"
+#undef FONT_ROW
+};
+
+const unsigned int fontWideWire[FONT_SIZE + 1] = {	// double-width font in display format
+#define FONT_ROW(b) FONT_WINV(b),
+#include "fontrows.h"
+#undef FONT_ROW
+};
+
+const unsigned int fontWide[FONT_SIZE + 1] = {	// double-width font for DISP_INVERT
+#define FONT_ROW(b) FONT_WIDE(b),
+#include "fontrows.h"
+#undef FONT_ROW
+};
+#endif
+
 void SPIWriteByte(unsigned char value);
 void SPIWriteWord(unsigned int value);
-void SPIWriteLine(unsigned char line);
+void SPIWriteLine(unsigned char line, unsigned char count);
 void printSharp(const char* text, unsigned char line, unsigned char options);
+unsigned char BCDIncrement(unsigned char value);
 
 extern void doubleWideAsm(unsigned char c, unsigned char* buff);
 
 int main(void)
 {
+	unsigned char shownSecond = 0xff;					// clock seconds on display, BCD
+
 	// configure WDT
 	WDTCTL = WDTPW | WDTHOLD;							// stop watch dog timer
 
@@ -90,11 +170,11 @@ int main(void)
 	// configure UCSI B0 for SPI
 	UCB0CTL1 |= UCSWRST;								// reset USCI B0
 	UCB0CTL0 = UCCKPH | UCMST | UCMODE_0 | UCSYNC;		// read on rising edge, inactive clk low, lsb, 8 bit, master mode, 3 pin SPI, synchronous
-	UCB0BR0 = 8; UCB0BR1 = 0;							// clock scaler = 8, i.e 2 MHz SPI clock
+	UCB0BR0 = 8; UCB0BR1 = 0;							// clock scaler = 8, i.e. ~140 kHz SPI clock with default DCO of ~1.1 MHz
 	UCB0CTL1 = UCSSEL_2;								// clock source SMCLK, clear UCSWRST to enable USCI B0
 	UCB0CTL1 &= ~UCSWRST;								// enable USCI B0
 
-	// setup timer A, to keep time and alternate VCOM at 1Hz
+	// setup timer A, to keep time and alternate VCOM at 2Hz
 	timeMSec = 0;										// initialize variables used by "clock"
 	timeSecond = 0;
 	timeMinute = 0;
@@ -108,11 +188,19 @@ int main(void)
 
 	P2OUT |= _DISP;										// turn  display on
 
+#ifdef PROFILE
+	profile();											// display is cleared afterwards
+	profileDone();
+#endif
+
 	// initialize display
 	P2OUT |= _SCS;										// SCS high, ready talking to display
 	SPIWriteByte(MLCD_CM | VCOM);						// send clear display memory command
 	SPIWriteByte(0);									// send command trailer
 	P2OUT &= ~_SCS;										// SCS lo, finished talking to display
+#ifdef SHARP_TRACE
+	traceRecord(MLCD_CM | VCOM, 0, 0);
+#endif
 
 	// write some text to display to demonstrate options
 	printSharp("HELLO,WORLD?",1,0);
@@ -133,21 +221,28 @@ int main(void)
 			P1OUT |= _LED;
 		}
 
-		// write clock to display
-		TextBuff[0] = ' ';
-		TextBuff[1] = timeMinute / 10 + '0';
-		TextBuff[2] = timeMinute % 10 + '0';
-		TextBuff[3] = ':';
-		TextBuff[4] = timeSecond / 10 + '0';
-		TextBuff[5] = timeSecond % 10 + '0';
-		TextBuff[6] = 0;
-		printSharp(TextBuff,72,DISP_HIGH | DISP_WIDE);
+		// write clock to display, once per second
+		if(timeSecond != shownSecond)
+		{
+			shownSecond = timeSecond;
+			TextBuff[0] = ' ';
+			TextBuff[1] = (timeMinute >> 4) + '0';		// time is kept in BCD, no division needed
+			TextBuff[2] = (timeMinute & 0x0f) + '0';
+			TextBuff[3] = ':';
+			TextBuff[4] = (shownSecond >> 4) + '0';
+			TextBuff[5] = (shownSecond & 0x0f) + '0';
+			TextBuff[6] = 0;
+			printSharp(TextBuff,72,DISP_HIGH | DISP_WIDE);
+		}
 
 		// put display into low-power static mode
 		P2OUT |= _SCS;									// SCS high, ready talking to display
 		SPIWriteByte(MLCD_SM | VCOM);					// send static mode command
 		SPIWriteByte(0);								// send command trailer
 		P2OUT &= ~_SCS;									// SCS lo, finished talking to display
+#ifdef SHARP_TRACE
+		traceRecord(MLCD_SM | VCOM, 0, 0);
+#endif
 
 		// sleep for a while
 		_BIS_SR(LPM0_bits + GIE);						// enable interrupts and go to sleep
@@ -168,7 +263,14 @@ void printSharp(const char* text, unsigned char line, unsigned char options)
 	// i = text index
 	// j = line buffer index
 	// k = char line
+	// n = index in font
 	unsigned char c, b, i, j, k;
+	unsigned int n;
+
+#ifdef FONT_TABLES
+	const unsigned char* rows = (options & DISP_INVERT) ? font8x8 : fontWire;	// tables already transformed for options
+	const unsigned int* wides = (options & DISP_INVERT) ? fontWide : fontWideWire;
+#endif
 
 	// rendering happens line-by-line because this display can only be written by line
 	k = 0;
@@ -183,18 +285,51 @@ void printSharp(const char* text, unsigned char line, unsigned char options)
 				c = ' ';
 			}
 
-			c = c - 32;									// convert character to index in font table
-			b = font8x8[(c*8)+k];						// retrieve byte defining one line of character
+#ifdef FONT_TABLES
+			n = FONT_GLYPH(c);							// characters not included in font use blank row
+			if(n < FONT_SIZE)
+			{
+				n += k;
+			}
+			b = rows[n];								// no inversion needed, table is in display format
+#else
+			n = FONT_GLYPH(c);							// characters not included in font use blank row
+			if(n < FONT_SIZE)
+			{
+				n += k;
+			}
+			b = font8x8[n];								// retrieve byte defining one line of character
 
 			if(!(options & DISP_INVERT))				// invert bits if DISP_INVERT is _NOT_ selected
 			{											// pixels are LOW active
 				b = ~b;
 			}
+#endif
 
-			if((options & DISP_WIDE) && (c != 0))		// double width rendering if DISP_WIDE and character is not SPACE
+			if((options & DISP_WIDE) && (c != ' '))	// double width rendering if DISP_WIDE and character is not SPACE
 			{
-				doubleWideAsm(b, &LineBuff[j]);			// implemented in assembly for efficiency/space reasons
-				j += 2;									// we've written two bytes to buffer
+#ifdef FONT_TABLES
+				LineBuff[j] = wides[n] >> 8;			// copy both halves from double-width table
+				j++;
+				if(j < (PIXELS_X/8))					// clip at right edge of display
+				{
+					LineBuff[j] = wides[n];
+					j++;
+				}
+#else
+				if(j == (PIXELS_X/8)-1)					// only left half fits, clip at right edge of display
+				{
+					unsigned char wide[2];
+					doubleWideAsm(b, wide);
+					LineBuff[j] = wide[0];
+					j++;
+				}
+				else
+				{
+					doubleWideAsm(b, &LineBuff[j]);		// implemented in assembly for efficiency/space reasons
+					j += 2;								// we've written two bytes to buffer
+				}
+#endif
 			}
 			else										// else regular rendering
 			{
@@ -211,11 +346,14 @@ void printSharp(const char* text, unsigned char line, unsigned char options)
 			j++;
 		}
 
-		SPIWriteLine(line++);							// write line buffer
-
-		if(options & DISP_HIGH && line < PIXELS_Y)	// repeat line if DISP_HIGH is selected
+		if(options & DISP_HIGH && line < PIXELS_Y-1)	// repeat line if DISP_HIGH is selected
+		{
+			SPIWriteLine(line, 2);						// both lines are sent in one transfer
+			line += 2;
+		}
+		else
 		{
-			SPIWriteLine(line++);
+			SPIWriteLine(line++, 1);					// write line buffer
 		}
 
 		k++;											// next pixel line
@@ -224,25 +362,40 @@ void printSharp(const char* text, unsigned char line, unsigned char options)
 
 // transfer line buffer to display using SPI
 // input: line	position where line buffer is rendered
-void SPIWriteLine(unsigned char line)
+//        count	number of consecutive lines receiving the same line buffer
+void SPIWriteLine(unsigned char line, unsigned char count)
 {
 	P2OUT |= _SCS;										// SCS high, ready talking to display
 
 	SPIWriteByte(MLCD_WR | VCOM);						// send command to write line(s)
-	SPIWriteByte(line+1);								// send line address
 
-	UCB0CTL0 |= UCMSB;									// switch SPI to MSB first for proper bitmap orientation
+#ifdef SHARP_TRACE
+	unsigned char start = TRACE_START;
+#endif
 
-	unsigned char j = 0;
-	while(j < (PIXELS_X/8))								// write pixels / 8 bytes
+	while(count--)										// repeat line buffer for each line
 	{
-		UCB0TXBUF = LineBuff[j++];						// transfer byte
-		while (UCB0STAT & UCBUSY);						// wait for transfer to complete
- 	}
+		SPIWriteByte(++line);							// send line address
+#ifdef SHARP_TRACE
+		traceRecord(MLCD_WR | VCOM | start, line, LineBuff);
+		start = 0;
+#endif
+
+		UCB0CTL0 |= UCMSB;								// switch SPI to MSB first for proper bitmap orientation
+
+		unsigned char j = 0;
+		while(j < (PIXELS_X/8))							// write pixels / 8 bytes
+		{
+			UCB0TXBUF = LineBuff[j++];					// transfer byte
+			while (UCB0STAT & UCBUSY);					// wait for transfer to complete
+		}
 
-	UCB0CTL0 &= ~UCMSB;									// switch SPI back to LSB first for commands
+		UCB0CTL0 &= ~UCMSB;								// switch SPI back to LSB first for commands
+
+		SPIWriteByte(0);								// send 8 bit to latch line
+	}
 
-	SPIWriteWord(0);									// send 16 bit to latch buffers and end transfer
+	SPIWriteByte(0);									// send another 8 bit to end transfer
 	P2OUT &= ~_SCS;										// SCS low, finished talking to display
 }
 
@@ -265,27 +418,134 @@ void SPIWriteWord(unsigned int value)
 	while (UCB0STAT & UCBUSY);
 }
 
+#ifdef SHARP_TRACE
+// add record to trace, overwriting the oldest record when full
+// input: cmd		command byte as sent
+//        line		line address as sent, 0 for commands without line
+//        data		line data, 0 for commands
+void traceRecord(unsigned char cmd, unsigned char line, const unsigned char* data)
+{
+	TraceRecord* r = &sharpTrace.record[sharpTrace.next];
+
+	if(++sharpTrace.next == SHARP_TRACE)
+	{
+		sharpTrace.next = 0;
+	}
+	sharpTrace.count++;
+
+	do													// time is updated by timer interrupt,
+	{													// read again if it changed while reading
+		r->time = traceMSec;
+	} while(r->time != traceMSec);
+
+	r->cmd = cmd;
+	r->line = line;
+
+	unsigned int hash = 0;
+	unsigned char j = 0;
+	while(data && j < (PIXELS_X/8))
+	{
+		hash = (((hash << 1) | (hash >> 15)) ^ data[j]) & 0xffff;	// rotate and xor, 16 bit as on the G2553
+#ifdef SHARP_TRACE_DATA
+		r->data[j] = data[j];
+#endif
+		j++;
+	}
+	r->hash = hash;
+}
+#endif
+
+#ifdef PROFILE
+// measure cycles of rendering functions, results are stored in profileCycles
+// timer A1 counts SMCLK, which runs at MCLK, so one count is one CPU cycle
+// code size per function is listed by msp430-elf-nm --size-sort -S
+void profile(void)
+{
+	unsigned char buff[2];
+	unsigned char options;
+
+	TA1CTL = TASSEL_2 + MC_2;							// SMCLK, continuous mode
+
+	PROFILE_START();									// cost of measurement itself
+	PROFILE_STOP(PROFILE_OVERHEAD);
+
+	P2OUT |= _SCS;										// SCS high, ready talking to display
+	PROFILE_START();
+	SPIWriteByte(MLCD_SM | VCOM);						// send static mode command
+	PROFILE_STOP(PROFILE_BYTE);
+	SPIWriteByte(0);									// send command trailer
+	P2OUT &= ~_SCS;										// SCS lo, finished talking to display
+
+	PROFILE_START();
+	doubleWideAsm(0x5a, buff);
+	PROFILE_STOP(PROFILE_WIDE);
+
+	PROFILE_START();
+	SPIWriteLine(0, 1);
+	PROFILE_STOP(PROFILE_LINE);
+
+	for(options = 0; options < 8; options++)			// all combinations of DISP_INVERT, DISP_WIDE and DISP_HIGH
+	{
+		PROFILE_START();
+		printSharp("HELLO,WORLD?", 0, options);
+		PROFILE_STOP(PROFILE_PRINT + options);
+	}
+
+	TA1CTL = MC_0;										// stop timer A1
+}
+
+// called when profileCycles is complete, the simulator stops here
+#ifdef __GNUC__
+__attribute__((noinline))
+#endif
+void profileDone(void)
+{
+	__no_operation();
+}
+#endif
+
+// increment 2 digit BCD value
+// input: value		BCD value, 0x00-0x98
+unsigned char BCDIncrement(unsigned char value)
+{
+	value++;
+	if((value & 0x0f) == 10)							// carry into tens digit
+	{
+		value += 6;
+	}
+	return value;
+}
+
 // interrupt service routine to handle timer A
 #pragma vector=TIMER0_A0_VECTOR
 __interrupt void handleTimerA(void)
 {
 	timeMSec++;											// count milliseconds
+#ifdef SHARP_TRACE
+	traceMSec++;
+#endif
+
+	if(timeMSec == 500)									// invert polarity also at half second, as the clock changes
+	{													// every second and its pixels would see only one polarity
+		VCOM ^= MLCD_VCOM;
+		_bic_SR_register_on_exit(LPM0_bits);			// wake up main loop to send it
+	}
 
 	if(timeMSec == 1000)								// if we reached 1 second
 	{
 		timeMSec = 0;									// reset milliseconds
-		timeSecond++;									// increase seconds
-		if(timeSecond == 60)							// if we reached 1 minute
+		timeSecond = BCDIncrement(timeSecond);			// increase seconds
+		if(timeSecond == 0x60)							// if we reached 1 minute
 		{
 			timeSecond = 0;								// reset seconds
-			timeMinute++;								// increase minutes
-			if(timeMinute == 60)						// if we reached 1 hour
+			timeMinute = BCDIncrement(timeMinute);		// increase minutes
+			if(timeMinute == 0x60)						// if we reached 1 hour
 			{
 				timeMinute = 0;							// reset minutes
 			}
 		}
 
-		VCOM ^= MLCD_VCOM;								// invert polarity bit every second
+		VCOM ^= MLCD_VCOM;								// and again at full second
 
 		_bic_SR_register_on_exit(LPM0_bits);			// wake up main loop every second
 	}
@@ -0,0 +1,155 @@
+#!/usr/bin/env python3
+# Golden image regression test, runs the scenarios of scenarios.txt and checks what reached the panel.
+# Distributed under MIT License, see license.txt for details.
+#
+# usage: check.py [--update] build [scenario...]
+#
+# Each scenario is a command, run in the build directory, that writes the bytes sent to the display
+# to {spi} with the Linux backend. The file is decoded with tools/sharptrace.py, and the content of
+# the panel after the last transfer is compared with the golden image golden/<golden>.pbm. The
+# bytes sent, without the headers of the file, must not exceed the budget of the scenario. On a
+# mismatch, the panel is written to the build directory as <scenario>.pbm for inspection. The
+# bytes must also follow the rules of the panel as checked by sharptrace.py --spi --check with its
+# default limits: whole bursts, SCLK, commands, line addresses, VCOM inversion and DC bias.
+#
+# With --update, golden images and budgets are set to the results of the run. Review the changes
+# with git diff before committing them.
+#
+# scenarios.txt has one scenario per line: name, golden, size (WIDTHxHEIGHT), budget in bytes and
+# the command. In the command, {spi} is the output file and {test} this directory.
+
+import argparse
+import os
+import subprocess
+import sys
+
+TEST = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, os.path.join(TEST, '..', 'tools'))
+
+import sharptrace
+
+
+class Scenario:
+
+    def __init__(self, text):
+        fields = text.split(None, 4)
+        self.text = text
+        self.name = fields[0]
+        self.golden = fields[1]
+        self.width, self.height = (int(n) for n in fields[2].split('x'))
+        self.budget = int(fields[3])
+        self.command = fields[4]
+
+
+def read_scenarios(path):
+    lines = []
+    with open(path) as f:
+        for text in f:
+            text = text.rstrip('\n')
+            if text.strip() and not text.startswith('#'):
+                lines.append(Scenario(text))
+            else:
+                lines.append(text)
+    return lines
+
+
+def write_scenarios(path, lines):
+    with open(path, 'w') as f:
+        for s in lines:
+            if isinstance(s, Scenario):
+                f.write('%-16s %-14s %-8s %7d  %s\n' % (s.name, s.golden, '%dx%d' % (s.width, s.height),
+                                                     s.budget, s.command))
+            else:
+                f.write(s + '\n')
+
+
+def wire_bytes(path):
+    """Bytes sent, without headers of bursts."""
+    return sum(len(data) for time, data in sharptrace.read_bursts(path)[1] if data)
+
+
+def read_pbm(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+    header, width, height, pixels = data.split(None, 3)
+    return int(width), int(height), pixels
+
+
+def run(s, build, update):
+    """Returns error message, or None if scenario passed."""
+    spi = os.path.join(build, s.name + '.spi')
+    command = s.command.format(spi=spi, test=TEST)
+    result = subprocess.run(command, shell=True, cwd=build, stdout=subprocess.PIPE,
+                            stderr=subprocess.STDOUT, timeout=300)
+    with open(os.path.join(build, s.name + '.log'), 'wb') as f:
+        f.write(result.stdout)
+    if result.returncode:
+        return 'exit code %d, see %s.log' % (result.returncode, s.name)
+
+    errors = []
+    records = sharptrace.read_spi(spi, s.width, errors, sharptrace.SCLK_MAX)
+    if records:
+        errors = sharptrace.violations(records, s.width, s.height, errors=errors)[0]
+    white = b'\xff' * (s.width // 8)
+    panel = [white] * s.height
+    for panel in sharptrace.frames(records, s.width, s.height):
+        pass
+    sent = wire_bytes(spi)
+
+    golden = os.path.join(TEST, 'golden', s.golden + '.pbm')
+    if update:
+        if s.golden == s.name:
+            sharptrace.write_pbm(golden, panel, s.width, s.height)
+        s.budget = sent
+        return None
+
+    actual = os.path.join(build, s.name + '.pbm')
+    sharptrace.write_pbm(actual, panel, s.width, s.height)
+    if not os.path.exists(golden):
+        errors.append('no golden image %s.pbm' % s.golden)
+    elif read_pbm(golden) != read_pbm(actual):
+        width, height, expected = read_pbm(golden)
+        pixels = read_pbm(actual)[2]
+        stride = s.width // 8
+        lines = [y for y in range(s.height) if expected[y * stride:(y + 1) * stride] != pixels[y * stride:(y + 1) * stride]]
+        if (width, height) != (s.width, s.height):
+            errors.append('golden image is %dx%d' % (width, height))
+        else:
+            errors.append('%d lines differ from %s.pbm, first %d' % (len(lines), s.golden, lines[0]))
+    if sent > s.budget:
+        errors.append('%d bytes sent, budget %d' % (sent, s.budget))
+    elif sent < s.budget and not errors:
+        return 'ok, %d bytes sent, budget %d can be lowered' % (sent, s.budget)
+    return ', '.join(errors) or None
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Run golden image regression tests')
+    parser.add_argument('build', help='directory with test programs')
+    parser.add_argument('scenario', nargs='*', help='only run these scenarios')
+    parser.add_argument('--update', action='store_true', help='set golden images and budgets to results')
+    args = parser.parse_intermixed_args()
+
+    path = os.path.join(TEST, 'scenarios.txt')
+    lines = read_scenarios(path)
+    build = os.path.abspath(args.build)
+
+    failed = 0
+    for s in lines:
+        if not isinstance(s, Scenario) or (args.scenario and s.name not in args.scenario):
+            continue
+        error = run(s, build, args.update)
+        if error and error.startswith('ok'):
+            print('%-16s %s' % (s.name, error))
+            continue
+        print('%-16s %s' % (s.name, 'FAIL: ' + error if error else 'ok'))
+        failed += error is not None
+
+    if args.update:
+        write_scenarios(path, lines)
+    print('%d failed' % failed if failed else 'all passed')
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == '__main__':
+    main()
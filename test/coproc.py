@@ -0,0 +1,67 @@
+#!/usr/bin/env python3
+# Drives the SHARPCoprocessor sketch over a pseudo terminal with the client of tools/sharpcoproc.py.
+# Distributed under MIT License, see license.txt for details.
+#
+# usage: coproc.py sketch output.spi
+#
+# Runs the sketch with -p, so its Serial is a pseudo terminal, and draws text, a fill and image.pbm.
+# A bitmap frame whose data ends before its row is complete must be rejected with a NAK without
+# drawing anything. The sketch stops when the port is closed.
+
+import os
+import subprocess
+import sys
+
+TEST = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, os.path.join(TEST, '..', 'tools'))
+
+import sharpcoproc
+from sharpcoproc import CMD_BITMAP, DISP_INVERT, DISP_WIDE
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.stderr.write('usage: coproc.py sketch output.spi\n')
+        sys.exit(2)
+
+    sketch = subprocess.Popen([sys.argv[1], '-p', '-e', sys.argv[2]], stdout=subprocess.PIPE)
+    errors = 0
+    try:
+        port = sharpcoproc.open_port(sketch.stdout.readline().decode().strip(), 9600)
+        lcd = sharpcoproc.Coprocessor(port, retries=0)
+
+        lcd.text(' COPROCESSOR', 0, DISP_INVERT)
+        lcd.fill(8, 2, 0xff)
+        data, width, height = sharpcoproc.read_pbm(os.path.join(TEST, 'image.pbm'))
+        lcd.bitmap(data, width, height, 16)
+        lcd.text('PTY', 72, DISP_WIDE)
+        lcd.sync()
+
+        try:                                # literal run of 4 bytes with only 2 of them
+            lcd._send(bytes([CMD_BITMAP, 80, 4, 2, 3, 0x00, 0x00]))
+            print('truncated bitmap was acknowledged')
+            errors += 1
+        except IOError as e:
+            print('truncated bitmap: %s' % e)
+
+        lcd.text('STILL ALIVE', 88)
+        lcd.sync()
+        print('%d frames, %d resent' % (lcd.frames, lcd.resent))
+        port.close()
+    except IOError as e:
+        print(e)
+        errors += 1
+    finally:
+        try:
+            sketch.wait(10)
+        except subprocess.TimeoutExpired:
+            sketch.terminate()
+            sketch.wait()
+            print('sketch did not stop when the port was closed')
+            errors += 1
+
+    sys.exit(1 if errors or sketch.returncode else 0)
+
+
+if __name__ == '__main__':
+    main()
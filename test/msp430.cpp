@@ -0,0 +1,108 @@
+// Runs main.c on the Linux backend with the registers of msp430.h.
+// Distributed under MIT License, see license.txt for details.
+//
+// usage: main [-s seconds] output.spi
+//
+// Bursts are written to output.spi with simulated time. Each time main.c sleeps, the timer
+// interrupt runs every millisecond until it wakes up main.c again. Once -s seconds (default 1)
+// have passed, the program ends the next time main.c sleeps.
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "SHARPLinux.h"
+#include "msp430.h"
+
+#define SCLK 140000                             // SMCLK/8 with default DCO
+
+volatile unsigned int WDTCTL, TA0CTL, TACCR0, TACCTL0, TA1CTL, TA1R;
+volatile unsigned char P1DIR, P1OUT, P1SEL, P1SEL2, P2DIR;
+volatile unsigned char UCB0CTL0, UCB0CTL1, UCB0BR0, UCB0BR1, UCB0STAT;
+Port2 P2OUT;
+TxBuffer UCB0TXBUF;
+
+int msp430Main(void);
+
+static long seconds = 1;
+static long ms;                                 // time passed in lowPower
+static char woken;
+
+void Port2::set(unsigned char value)
+{
+    if ((value ^ m_value) & BIT5) {
+        digitalWrite(SPIDEV_CS, value & BIT5 ? HIGH : LOW);
+    }
+    m_value = value;
+}
+
+TxBuffer& TxBuffer::operator=(unsigned char value)
+{
+    SPI.setBitOrder(UCB0CTL0 & UCMSB ? MSBFIRST : LSBFIRST);
+    SPI.transfer(value);
+    return *this;
+}
+
+// timer A0 interrupts every millisecond until it wakes up main.c
+void lowPower(void)
+{
+    if (ms >= seconds * 1000) {
+        SHARPLinux.end();
+        exit(0);
+    }
+
+    woken = 0;
+    while (!woken) {
+        delay(1);
+        ms++;
+        handleTimerA();
+    }
+}
+
+// interrupt clears low power bits on exit
+void wakeUp(void)
+{
+    woken = 1;
+}
+
+// double-width pixels of c, as doublewide.asm on MSP430
+void doubleWideAsm(unsigned char c, unsigned char* buff)
+{
+    unsigned int w = 0;
+
+    for (int i = 0; i < 8; i++) {
+        if (c & (1 << i)) {
+            w |= 3 << (2 * i);
+        }
+    }
+    buff[0] = w >> 8;
+    buff[1] = w;
+}
+
+int main(int argc, char** argv)
+{
+    int opt;
+
+    while ((opt = getopt(argc, argv, "s:")) != -1) {
+        switch (opt) {
+        case 's':
+            seconds = atol(optarg);
+            break;
+        default:
+            seconds = -1;
+        }
+    }
+    if (optind != argc - 1 || seconds < 0) {
+        fprintf(stderr, "usage: main [-s seconds] output.spi\n");
+        return 2;
+    }
+
+    SHARPLinux.simulateTime();
+    if (SHARPLinux.begin(argv[optind], SCLK) < 0) {
+        perror(argv[optind]);
+        return 1;
+    }
+
+    return msp430Main();
+}
@@ -0,0 +1,68 @@
+// Registers of MSP430G2553 used by main.c, mapped to the Linux backend to run main.c on a host.
+// Distributed under MIT License, see license.txt for details.
+//
+// main.c is compiled as C++ with -Dmain=msp430Main. Bytes written to UCB0TXBUF are sent with
+// SPI.transfer, in the bit order selected by UCMSB. SCS on P2.5 is chip select of the backend.
+// Sleeping in low power mode runs the timer interrupt for a second, see msp430.cpp.
+
+#ifndef __MSP430_H__
+#define __MSP430_H__
+
+#define BIT0 0x01
+#define BIT5 0x20
+#define BIT7 0x80
+
+#define WDTPW 0x5a00
+#define WDTHOLD 0x0080
+#define UCSWRST 0x01
+#define UCSSEL_2 0x80
+#define UCCKPH 0x80
+#define UCMSB 0x20
+#define UCMST 0x08
+#define UCMODE_0 0x00
+#define UCSYNC 0x01
+#define UCBUSY 0x01
+#define TASSEL_2 0x0200
+#define MC_0 0x0000
+#define MC_1 0x0010
+#define MC_2 0x0020
+#define CCIE 0x0010
+#define GIE 0x0008
+#define LPM0_bits 0x0010
+
+#define __interrupt
+
+class Port2                                     // P2OUT, SCS is chip select
+{
+private:
+    unsigned char m_value;
+    void set(unsigned char value);
+
+public:
+    Port2& operator=(unsigned char value) { set(value); return *this; }
+    Port2& operator|=(unsigned char bits) { set(m_value | bits); return *this; }
+    Port2& operator&=(unsigned char bits) { set(m_value & bits); return *this; }
+    operator unsigned char() const { return m_value; }
+};
+
+class TxBuffer                                  // UCB0TXBUF, sends each byte written
+{
+public:
+    TxBuffer& operator=(unsigned char value);
+};
+
+extern volatile unsigned int WDTCTL, TA0CTL, TACCR0, TACCTL0, TA1CTL, TA1R;
+extern volatile unsigned char P1DIR, P1OUT, P1SEL, P1SEL2, P2DIR;
+extern volatile unsigned char UCB0CTL0, UCB0CTL1, UCB0BR0, UCB0BR1, UCB0STAT;
+extern Port2 P2OUT;
+extern TxBuffer UCB0TXBUF;
+
+void handleTimerA(void);
+void lowPower(void);
+void wakeUp(void);
+
+#define _BIS_SR(bits) lowPower()
+#define _bic_SR_register_on_exit(bits) wakeUp()
+#define __no_operation()
+
+#endif
@@ -0,0 +1,641 @@
+// Scenarios of the Energia library for the golden image tests, run on the Linux backend.
+// Distributed under MIT License, see license.txt for details.
+//
+// usage: sharptest scenario output.spi
+//
+// Each scenario draws with one feature of the library, see scenarios.txt for the images they are
+// compared with. Pins and time are simulated. A scenario returns non-zero if a check it makes
+// beyond the image fails, e.g. on what is sent while drawing.
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "SHARPLinux.h"
+#include "SHARPMemLCDTxt.h"
+#include "SHARPMemLCDChart.h"
+#include "SHARPMemLCDConsole.h"
+#include "SHARPMemLCDDither.h"
+#include "SHARPMemLCDGray.h"
+#include "SHARPMemLCDNumber.h"
+#include "SHARPMemLCDSink.h"
+
+static const unsigned char arrow[] = {          // 13x9, odd width to test padding
+    0x02, 0x00, 0x03, 0x00, 0x03, 0x80, 0xff, 0xc0, 0xff, 0xe0,
+    0xff, 0xc0, 0x03, 0x80, 0x03, 0x00, 0x02, 0x00
+};
+
+static unsigned char frame[PIXELS_X*PIXELS_Y/8];
+
+// all combinations of options, each line of text as high as the options make it
+static int printOptions(SHARPMemLCDTxt& display, char first)
+{
+    int line = 0;
+
+    for (char options = first; options < first + 8; options++) {
+        display.print("HELLO,WORLD?", line, options);
+        line += options & DISP_HIGH ? 16 : 8;
+    }
+    return 0;
+}
+
+static int text(SHARPMemLCDTxt& display)
+{
+    return printOptions(display, 0);
+}
+
+static int bold(SHARPMemLCDTxt& display)
+{
+    return printOptions(display, DISP_BOLD);
+}
+
+static int edges(SHARPMemLCDTxt& display)
+{
+    display.print("ABOVE", -4);                 // partially above display
+    display.print("0123456789ABCDEF", 8);       // clipped at right edge
+    display.print("WIDE CLIP", 16, DISP_WIDE);
+    display.print("~{|}", 24);                  // outside of font
+    display.print("", 32, DISP_INVERT);         // empty text clears line
+    display.print("HIGH", 84, DISP_HIGH);       // clipped at bottom
+    return 0;
+}
+
+static int scale(SHARPMemLCDTxt& display)
+{
+    display.setScale(2, 2);
+    display.print("AB", 0);
+    display.setScale(3, 2);
+    display.print("XYZ", 16, DISP_INVERT);
+    display.setScale(1, 3);
+    display.print("TALL", 32);
+    display.setScale(4, 4);
+    display.print("CLIP", 64);                  // clipped at right and bottom edge
+    display.setScale(1, 1);
+    return 0;
+}
+
+static int formats(SHARPMemLCDTxt& display)
+{
+    display.printf(0, 0, "%d %u", -42, 42U);
+    display.printf(8, 0, "%5d|%-4d|", 7, 7);
+    display.printf(16, 0, "%03d %x", 7, 0xBEEF);
+    display.printf(24, 0, "%ld", -123456789L);
+    display.printf(32, 0, "%s %c%%", "STR", 'C');
+    display.printf(40, DISP_INVERT, "%8.3d", 5);      // fixed point
+    display.printf(48, 0, "%.2d V %.1ld", -314, 99L);
+    display.printf(56, DISP_WIDE, "%d", 12345);
+    display.printf(64, 0, "%ld", -2147483647L - 1);   // most negative long of MSP430
+    display.printf(72, 0, "%s", "TRUNCATED AT WIDTH");
+    return 0;
+}
+
+static int bitmaps(SHARPMemLCDTxt& display)
+{
+    display.bitmap(arrow, 13, 9, 0);
+    display.bitmap(arrow, 13, 9, 12, DISP_INVERT);
+    display.bitmap(arrow, 13, 9, -4);           // partially above display, overlaps first
+    display.setScale(2, 2);
+    display.bitmap(arrow, 13, 9, 24);
+    display.bitmap(arrow, 13, 9, 88);           // clipped at bottom
+    display.setScale(1, 1);
+    return 0;
+}
+
+static int fills(SHARPMemLCDTxt& display)
+{
+    display.fill(0, 8, 0xff);                   // set bits are black
+    display.fill(8, 8, 0xaa);
+    display.fill(16, 8, 0xf0);
+    display.fill(90, 20, 0xff);                 // clipped at bottom
+    display.clear(4, 8);                        // partial clear inside range
+    return 0;
+}
+
+// calls that affect no line must not send anything, not even an empty transaction
+static int unchanged(const char* call, unsigned long bytes)
+{
+    if (SHARPLinux.bytes != bytes) {
+        fprintf(stderr, "%s sent %lu bytes\n", call, SHARPLinux.bytes - bytes);
+        return 1;
+    }
+    return 0;
+}
+
+static int clears(SHARPMemLCDTxt& display)
+{
+    unsigned long bytes;
+    int errors = 0;
+
+    display.print("CLEAR", 0);
+    display.clear(0, 8);                        // rest is blank, CMD_CLR
+    display.print("TOP", 0);
+    display.print("MIDDLE", 40);
+    display.print("BOTTOM", 88);
+    display.clear(36, 16);                      // burst of the 8 lines that are not blank
+
+    bytes = SHARPLinux.bytes;
+    display.clear(36, 16);
+    errors += unchanged("clear of blank lines", bytes);
+    display.fill(0, 0, 0xff);
+    errors += unchanged("fill of no lines", bytes);
+    display.fill(-20, 10, 0xff);
+    errors += unchanged("fill above display", bytes);
+    display.fill(PIXELS_Y, 10, 0xff);
+    errors += unchanged("fill below display", bytes);
+    display.print("GONE", -8);
+    errors += unchanged("print above display", bytes);
+    display.print("GONE", PIXELS_Y, DISP_HIGH);
+    errors += unchanged("print below display", bytes);
+    display.printf(PIXELS_Y, 0, "%d", 1);
+    errors += unchanged("printf below display", bytes);
+    display.bitmap(arrow, 13, 0, 48);
+    errors += unchanged("bitmap without rows", bytes);
+
+    display.fill(60, 8, 0x55);
+    display.clear(56, 16);                      // not all blank, burst of the 8 filled lines
+    return errors;
+}
+
+// 90 and 270 degrees are rejected on panels that are not square, output is not rotated then
+static int rotation(SHARPMemLCDTxt& display, char rotation)
+{
+    char supported = PIXELS_X == PIXELS_Y || !(rotation & 1);
+
+    display.attach(frame);
+    display.clear();
+    if (display.setRotation(rotation) != supported) {
+        fprintf(stderr, "setRotation(%d) returned %d\n", rotation, !supported);
+        return 1;
+    }
+    display.print("ROTATION", 0);
+    display.print("  WIDE", 8, DISP_WIDE);
+    display.bitmap(arrow, 13, 9, 24);
+    display.fill(88, 4, 0x0f);
+    display.flush();
+    display.attach(0);
+    return 0;
+}
+
+// same image as rotation, drawn once for each band of 8 columns instead of into a frame buffer,
+// or a single pass with 180 degrees
+static int band(SHARPMemLCDTxt& display, char rotation)
+{
+    static unsigned char strip[PIXELS_Y];
+    unsigned long bytes;
+    int errors = 0;
+
+    display.setRotation(rotation);
+    if (rotation & 1) {                         // 90 and 270 degrees can't be drawn without buffer
+        bytes = SHARPLinux.bytes;
+        display.print("DIRECT", 0);
+        errors += unchanged("print without band", bytes);
+        display.fill(88, 4, 0x0f);
+        errors += unchanged("fill without band", bytes);
+    }
+
+    display.firstBand(strip);
+    do {
+        display.clear();
+        display.print("ROTATION", 0);
+        display.print("  WIDE", 8, DISP_WIDE);
+        display.bitmap(arrow, 13, 9, 24);
+        display.fill(88, 4, 0x0f);
+    } while (display.nextBand());
+    return errors;
+}
+
+static int band90(SHARPMemLCDTxt& display)
+{
+    return band(display, DISP_ROT_90);
+}
+
+static int band270(SHARPMemLCDTxt& display)
+{
+    return band(display, DISP_ROT_270);
+}
+
+static int band180(SHARPMemLCDTxt& display)
+{
+    return band(display, DISP_ROT_180);
+}
+
+static int rot0(SHARPMemLCDTxt& display)
+{
+    return rotation(display, DISP_ROT_0);
+}
+
+static int rot90(SHARPMemLCDTxt& display)
+{
+    return rotation(display, DISP_ROT_90);
+}
+
+static int rot180(SHARPMemLCDTxt& display)
+{
+    return rotation(display, DISP_ROT_180);
+}
+
+static int rot270(SHARPMemLCDTxt& display)
+{
+    return rotation(display, DISP_ROT_270);
+}
+
+static int mirror(SHARPMemLCDTxt& display)
+{
+    return rotation(display, DISP_ROT_0 | DISP_MIRROR);
+}
+
+// text that differs in characters, options or scale, drawn into frame with or without cache
+static void cacheKeys(SHARPMemLCDTxt& display)
+{
+    display.attach(frame);
+    display.clear();
+    display.print("AB", 0);
+    display.print("BA", 8);
+    display.print("HELLO", 16);
+    display.print("HELLP", 24);
+    display.print("AB", 32, DISP_INVERT);
+    display.print("AB", 40, DISP_WIDE | DISP_BOLD);
+    display.setScale(2, 1);
+    display.print("AB", 48);
+    display.setScale(1, 1);
+    display.attach(0);
+}
+
+// same image as text, with lines of text from the cache the second time
+static int cache(SHARPMemLCDTxt& display)
+{
+    static unsigned char buffer[2048];
+    static unsigned char uncached[sizeof(frame)];
+    int errors = 0;
+
+    cacheKeys(display);                         // texts that must not be mistaken for each other
+    memcpy(uncached, frame, sizeof(frame));
+    display.setCache(buffer, sizeof(buffer));
+    cacheKeys(display);
+    if (memcmp(frame, uncached, sizeof(frame))) {
+        fprintf(stderr, "cache: lines of a different text, options or scale were reused\n");
+        errors++;
+    }
+
+    display.setCache(buffer, sizeof(buffer));
+    printOptions(display, 0);
+    unsigned int hits = display.cacheHits();
+    unsigned int misses = display.cacheMisses();
+    display.clear();
+    printOptions(display, 0);
+    if (display.cacheMisses() != misses || display.cacheHits() != hits + hits + misses) {
+        fprintf(stderr, "cache: second print rendered %u of %u rows\n", display.cacheMisses() - misses,
+                display.cacheHits() - hits + display.cacheMisses() - misses);
+        errors++;
+    }
+    display.setCache(0, 0);
+    return errors;
+}
+
+static int async(SHARPMemLCDTxt& display)
+{
+    int polls = 0;
+
+    display.printAsync("ASYNC TEXT", 0, DISP_HIGH);
+    while (!display.poll(1)) {                  // one line per call
+        polls++;
+    }
+    display.bitmapAsync(arrow, 13, 9, 24);
+    while (!display.poll(0)) {
+        polls++;
+    }
+    if (polls < 16) {
+        fprintf(stderr, "async: %d polls, lines were not spread over calls\n", polls);
+        return 1;
+    }
+    return 0;
+}
+
+static int console(SHARPMemLCDTxt& display)
+{
+    SHARPMemLCDConsole console(display, 8, 8);
+
+    display.print("  CONSOLE   ", 0, DISP_INVERT);
+    for (int i = 0; i < 20; i++) {              // scrolls
+        console.print("LINE ");
+        console.println(i);
+    }
+    console.print("NO NEWLINE");
+    console.update();
+
+    SHARPMemLCDConsole single(display, 76, 0);  // no rows is clamped to one
+    display.setScale(2, 1);                     // console is drawn unscaled, display keeps its scale
+    single.println("SCROLLED");
+    single.print("ONE ROW");
+    display.print("AB", 88);
+    display.setScale(1, 1);
+    return 0;
+}
+
+// text of number after count increments from 0
+static int counted(SHARPMemLCDNumber& number, long count, const char* expected)
+{
+    while (count-- > 0) {
+        number.increment();
+    }
+    if (strcmp(number.text(), expected) != 0) {
+        fprintf(stderr, "number: %s instead of %s\n", number.text(), expected);
+        return 1;
+    }
+    return 0;
+}
+
+static int number(SHARPMemLCDTxt& display)
+{
+    SHARPMemLCDNumber counter(display, "99999", 0, DISP_WIDE);
+    SHARPMemLCDNumber clock(display, "59:59", 24, DISP_HIGH);
+    SHARPMemLCDNumber minutes(display, " 98:59", 48);
+    SHARPMemLCDNumber day(display, "23:59:59", 64);
+    int errors = 0;
+
+    counter.set(9995);
+    for (int i = 0; i < 10; i++) {
+        counter.increment();
+        counter.update();
+    }
+    errors += counted(clock, 3599, "59:59");
+    clock.update();
+
+    errors += counted(minutes, 540, " 09:00");  // ones of minutes go past 8
+    errors += counted(minutes, 19 * 60 - 1, " 27:59");
+    errors += counted(minutes, 71 * 60, " 98:59");
+    errors += counted(minutes, 1, " 00:00");    // field rolls over at its own value
+    errors += counted(minutes, 60 * 60, " 60:00");
+    minutes.update();
+
+    errors += counted(day, 86399, "23:59:59");
+    errors += counted(day, 1, "00:00:00");
+    errors += counted(day, 19 * 3600 + 9 * 60 + 9, "19:09:09");
+    day.update();
+    return errors;
+}
+
+static int sink(SHARPMemLCDTxt& display)
+{
+    static const char pbm[] = "P4\n# comment\n13 9\n";
+    static const char xbm[] = "#define a_width 13\n#define a_height 9\nstatic char a_bits[] = {\n"
+                              "0x40,0x00,0xc0,0x00,0xc0,0x01,0xff,0x03,0xff,0x07,\n"
+                              "0xff,0x03,0xc0,0x01,0xc0,0x00,0x40,0x00};\n";
+    SHARPMemLCDSink sink(display);
+
+    sink.begin(SINK_PBM, 0);
+    sink.write((const uint8_t*)pbm, sizeof(pbm) - 1);
+    sink.write(arrow, sizeof(arrow));
+    if (sink.done() <= 0) return 1;
+
+    sink.begin(SINK_RAW, 16, DISP_INVERT, 13, 9);
+    sink.write(arrow, sizeof(arrow));
+    if (sink.done() <= 0) return 1;
+
+    sink.begin(SINK_XBM, 32);
+    sink.write(xbm);
+    if (sink.done() <= 0) return 1;
+
+    sink.begin(SINK_PBM, 48);
+    sink.write("P5\n1 1\n255\n");               // gray map is rejected
+    if (sink.done() >= 0) return 1;
+
+    sink.begin(SINK_RAW, -4, 0, 13, 9);         // partially above display, lower rows are drawn
+    sink.write(arrow, sizeof(arrow));
+    if (sink.done() <= 0) return 1;
+
+    sink.begin(SINK_RAW, 60, 0, 13, 9);         // each line is sent as soon as its last byte arrived
+    for (unsigned int i = 0; i < sizeof(arrow); i++) {
+        unsigned long bytes = SHARPLinux.bytes;
+        sink.write(arrow[i]);
+        if ((SHARPLinux.bytes != bytes) != (i & 1)) {
+            fprintf(stderr, "sink: %lu bytes sent after byte %u of row\n", SHARPLinux.bytes - bytes, i & 1);
+            return 1;
+        }
+    }
+    if (sink.done() <= 0) return 1;
+
+    sink.begin(SINK_RAW, 80, 0, 13, 200);       // clipped at bottom, beyond range of line
+    for (int i = 0; i < 200; i++) {
+        sink.write(arrow + i % 9 * 2, 2);
+    }
+    if (sink.done() <= 0) return 1;
+    return 0;
+}
+
+// lower half of a 400x240 panel, lines beyond 127 must be addressed like all others
+static int tall(SHARPMemLCDTxt& display)
+{
+    SHARPMemLCDNumber counter(display, "9999", 100, DISP_WIDE);
+    unsigned long bytes;
+    int errors = 0;
+
+    for (int line = 0; line < PIXELS_Y; line += 40) {
+        display.printf(line, 0, "LINE %d", line);
+    }
+    display.fill(124, 8, 0xaa);                 // across line 128
+    display.setScale(2, 2);
+    display.print("SCALED", 176);
+    display.setScale(1, 1);
+    display.bitmap(arrow, 13, 9, PIXELS_Y - 4); // clipped at bottom
+    display.printAsync("ASYNC", 150, DISP_INVERT);
+    display.poll(0);
+    counter.set(1234);
+    counter.update();
+
+    display.fill(216, 8, 0xff);
+    display.clear(212, 16);                     // burst of the 8 filled lines
+
+    bytes = SHARPLinux.bytes;
+    display.clear(212, 16);
+    errors += unchanged("clear of blank lines", bytes);
+    display.fill(PIXELS_Y, 10, 0xff);
+    errors += unchanged("fill below display", bytes);
+    display.print("GONE", PIXELS_Y);
+    errors += unchanged("print below display", bytes);
+    return errors;
+}
+
+// a band of gray image for each mode, odd width so that the last byte is padded. with batch, rows
+// are also dithered by convertRows, in batches of different size and with a row converted alone
+// in between, and must match convert
+static int dithers(SHARPMemLCDTxt& display, char batch)
+{
+    static const char modes[3] = { DITHER_BAYER, DITHER_FLOYD, DITHER_ATKINSON };
+    static unsigned char gray[PIXELS_Y/3][PIXELS_X];
+    static unsigned char rows[PIXELS_Y/3][PIXELS_X/8];
+    static unsigned char batched[PIXELS_Y/3][PIXELS_X/8];
+    const int width = PIXELS_X - 3;
+    const int height = PIXELS_Y/3;
+    int errors = 0;
+
+    for (int y = 0; y < height; y++) {          // gradient with a ripple, so errors vary from row to row
+        for (int x = 0; x < PIXELS_X; x++) {
+            gray[y][x] = x * 200 / PIXELS_X + (x * y + y * 37) % 56;
+        }
+    }
+
+    for (int m = 0; m < 3; m++) {
+        SHARPMemLCDDither dither(modes[m]);
+
+        dither.begin(width);
+        for (int y = 0; y < height; y++) {
+            dither.convert(gray[y], rows[y]);
+        }
+
+        if (batch) {
+            memset(batched, 0, sizeof(batched));
+            dither.begin(width);
+            dither.convertRows(gray[0], PIXELS_X, batched[0], PIXELS_X/8, 4);
+            dither.convert(gray[4], batched[4]);
+            dither.convertRows(gray[5], PIXELS_X, batched[5], PIXELS_X/8, height - 5);
+            for (int y = 0; y < height; y++) {
+                if (memcmp(rows[y], batched[y], (width + 7) / 8) != 0) {
+                    fprintf(stderr, "dither mode %d: row %d of convertRows differs from convert\n", modes[m], y);
+                    errors++;
+                    break;
+                }
+            }
+            memcpy(rows, batched, sizeof(rows));
+        }
+
+        display.bitmap(rows[0], width, height, m * height);
+    }
+    return errors;
+}
+
+static int dither(SHARPMemLCDTxt& display)
+{
+    return dithers(display, 0);
+}
+
+static int ditherBatch(SHARPMemLCDTxt& display)
+{
+    return dithers(display, 1);
+}
+
+// bars of 4 gray levels below white lines, as SHARPGray draws them. the first subframe sends every
+// line, the next ones all lines of the bars, which are more than a char counts on 240 lines
+static int grays(SHARPMemLCDTxt& display)
+{
+    static unsigned char image[PIXELS_X*PIXELS_Y*2/8];
+    static unsigned char shadow[PIXELS_X*PIXELS_Y/8];
+    SHARPMemLCDGray gray(display, GRAY_2BPP);
+    int errors = 0;
+
+    for (int y = 0; y < PIXELS_Y; y++) {
+        for (int x = 0; x < PIXELS_X; x++) {
+            unsigned char level = (y < 8) ? 3 : x * 4 / PIXELS_X;
+            int bit = (y * PIXELS_X + x) * 2;
+            image[bit / 8] |= level << (6 - bit % 8);
+        }
+    }
+
+    gray.begin(image, shadow);
+    for (int subframe = 0; subframe < 3; subframe++) {
+        int expected = subframe ? PIXELS_Y - 8 : PIXELS_Y;
+        int sent = gray.tick();
+        if (sent != expected) {
+            fprintf(stderr, "gray: subframe %d sent %d lines instead of %d\n", subframe, sent, expected);
+            errors++;
+        }
+    }
+    return errors;
+}
+
+struct Scenario {
+    const char* name;
+    int (*run)(SHARPMemLCDTxt& display);
+};
+
+// chart as high as the display, charts partly and fully outside of it
+static int chart(SHARPMemLCDTxt& display)
+{
+    static unsigned char plane[PIXELS_X/8*PIXELS_Y];
+    SHARPMemLCDChart full(display, 0, PIXELS_Y);
+    unsigned long bytes;
+    int errors = 0;
+
+    full.begin(plane);
+    for (int x = 0; x < PIXELS_X; x++) {        // triangle from bottom to top and back
+        int v = x*3 % (2*PIXELS_Y - 2);
+        full.add(v < PIXELS_Y ? v : 2*PIXELS_Y - 2 - v, 0);
+    }
+    full.flush();
+
+    SHARPMemLCDChart above(display, -8, 16);    // top half clipped, 8 lines sent
+    above.begin(plane);
+    above.add(12);
+
+    SHARPMemLCDChart below(display, PIXELS_Y, 16);
+    below.begin(plane);
+    bytes = SHARPLinux.bytes;
+    below.add(4);
+    errors += unchanged("chart below display", bytes);
+    SHARPMemLCDChart outside(display, -16, 16);
+    outside.begin(plane);
+    outside.add(4);
+    errors += unchanged("chart above display", bytes);
+    return errors;
+}
+
+static const Scenario scenarios[] = {
+    { "text", text },
+    { "bold", bold },
+    { "edges", edges },
+    { "scale", scale },
+    { "printf", formats },
+    { "bitmap", bitmaps },
+    { "fill", fills },
+    { "clear", clears },
+    { "rot0", rot0 },
+    { "rot90", rot90 },
+    { "rot180", rot180 },
+    { "rot270", rot270 },
+    { "mirror", mirror },
+    { "band90", band90 },
+    { "band270", band270 },
+    { "band180", band180 },
+    { "cache", cache },
+    { "async", async },
+    { "console", console },
+    { "number", number },
+    { "sink", sink },
+    { "dither", dither },
+    { "dither-batch", ditherBatch },
+    { "gray", grays },
+    { "chart", chart },
+    { "tall", tall },
+};
+
+int main(int argc, char** argv)
+{
+    const Scenario* s = 0;
+
+    for (unsigned int i = 0; argc == 3 && i < sizeof(scenarios) / sizeof(scenarios[0]); i++) {
+        if (strcmp(argv[1], scenarios[i].name) == 0) {
+            s = &scenarios[i];
+        }
+    }
+    if (!s) {
+        fprintf(stderr, "usage: sharptest scenario output.spi\n");
+        return 2;
+    }
+
+    SHARPLinux.simulateTime();
+    if (SHARPLinux.begin(argv[2]) < 0) {
+        perror(argv[2]);
+        return 1;
+    }
+
+    SHARPMemLCDTxt display;
+    display.begin();
+    display.clear();
+    display.on();
+
+    int result = s->run(display);
+
+    SHARPLinux.end();
+
+    return result;
+}
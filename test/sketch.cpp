@@ -0,0 +1,110 @@
+// Runs an Energia sketch of the examples on the Linux backend, linked with the sketch compiled as C++.
+// Distributed under MIT License, see license.txt for details.
+//
+// usage: sketch [-n loops] [-e] [-p] output.spi
+//
+// Bursts are written to output.spi, pins are simulated and time is simulated (SHARPLinuxClass::
+// simulateTime), so delays take no time and runs are reproducible. setup is called once and loop
+// -n times (default 1). With -e, loop is called until Serial, which reads stdin, reached the end
+// of input.
+//
+// With -p, Serial is the master of a pseudo terminal instead, and the name of the slave is printed,
+// so clients for the serial port of a board can talk to the sketch. Time is real. loop is called
+// until SIGINT or SIGTERM, or with -e until the client that sent the first bytes closes the slave.
+
+#include <Arduino.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "SHARPLinux.h"
+
+void setup();
+void loop();
+
+static volatile sig_atomic_t stopped;
+
+static void stop(int)
+{
+    stopped = 1;
+}
+
+// returns master of pseudo terminal after printing name of slave, or -1
+static int openPty()
+{
+    int fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if (fd < 0 || grantpt(fd) < 0 || unlockpt(fd) < 0) return -1;
+
+    printf("%s\n", ptsname(fd));
+    fflush(stdout);
+    return fd;
+}
+
+int main(int argc, char** argv)
+{
+    long loops = 1;
+    char input = 0;
+    char pty = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:ep")) != -1) {
+        switch (opt) {
+        case 'n':
+            loops = atol(optarg);
+            break;
+        case 'e':
+            input = 1;
+            break;
+        case 'p':
+            pty = 1;
+            break;
+        default:
+            loops = -1;
+        }
+    }
+    if (optind != argc - 1 || loops < 0) {
+        fprintf(stderr, "usage: sketch [-n loops] [-e] [-p] output.spi\n");
+        return 2;
+    }
+
+    if (pty) {
+        int fd = openPty();
+        if (fd < 0) {
+            perror("pty");
+            return 1;
+        }
+        Serial.attach(fd);
+        signal(SIGINT, stop);
+        signal(SIGTERM, stop);
+    } else {
+        SHARPLinux.simulateTime();
+    }
+    if (SHARPLinux.begin(argv[optind]) < 0) {
+        perror(argv[optind]);
+        return 1;
+    }
+
+    setup();
+
+    if (pty) {
+        while (input && !Serial && !stopped) {  // wait for client
+            loop();
+        }
+        while ((!input || Serial) && !stopped) {
+            loop();
+        }
+    } else if (input) {
+        while (Serial) {
+            loop();
+        }
+    } else {
+        while (loops--) {
+            loop();
+        }
+    }
+
+    SHARPLinux.end();
+
+    return 0;
+}
@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+# Encoder for delta encoded animations played by SHARPMemLCDAnim.
+# Distributed under MIT License, see license.txt for details.
+#
+# usage: sharpanim.py [-p period_ms] [-n name] [-b] output frame1.pbm frame2.pbm ...
+#
+# Frames are PBM images (P1 or P4), all of the same size. Width must match the display.
+# Output is a C header for use with Energia, or a binary file with -b.
+# Prints size of encoded animation and bytes sent to display compared to drawing
+# each frame with bitmap().
+
+import argparse
+import sys
+
+
+def read_pbm(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    # parse header tokens, skipping comments
+    tokens = []
+    pos = 0
+    while len(tokens) < 3:
+        while data[pos:pos + 1].isspace():
+            pos += 1
+        if data[pos:pos + 1] == b'#':
+            while data[pos:pos + 1] not in (b'\n', b''):
+                pos += 1
+            continue
+        start = pos
+        while not data[pos:pos + 1].isspace():
+            pos += 1
+        tokens.append(data[start:pos])
+    pos += 1
+
+    magic, width, height = tokens[0], int(tokens[1]), int(tokens[2])
+    stride = (width + 7) // 8
+
+    if magic == b'P4':
+        raw = data[pos:pos + stride * height]
+        rows = [raw[y * stride:(y + 1) * stride] for y in range(height)]
+    elif magic == b'P1':
+        bits = [c for c in data[pos - 1:].decode('ascii') if c in '01']
+        rows = []
+        for y in range(height):
+            row = bytearray(stride)
+            for x in range(width):
+                if bits[y * width + x] == '1':
+                    row[x >> 3] |= 0x80 >> (x & 7)
+            rows.append(bytes(row))
+    else:
+        sys.exit('%s: not a PBM image' % path)
+
+    return width, height, rows
+
+
+def encode(frames, stride, height, period):
+    out = bytearray(b'SA')
+    out += bytes([stride, height])
+    out += len(frames).to_bytes(2, 'little')
+    out += period.to_bytes(2, 'little')
+
+    previous = [bytes(stride)] * height     # first frame is encoded against white screen
+    changed_lines = []
+
+    for n, rows in enumerate(frames):
+        lines = bytearray((height + 7) // 8)
+        body = bytearray()
+        count = 0
+        for y in range(height):
+            delta = bytes(a ^ b for a, b in zip(rows[y], previous[y]))
+            if n > 0 and not any(delta):
+                continue
+            lines[y >> 3] |= 1 << (y & 7)
+            mask = bytearray((stride + 7) // 8)
+            data = bytearray()
+            for j, b in enumerate(delta):
+                if b:
+                    mask[j >> 3] |= 1 << (j & 7)
+                    data.append(b)
+            body += mask + data
+            count += 1
+        out += lines + body
+        changed_lines.append(count)
+        previous = rows
+
+    return out, changed_lines
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Encode PBM frames as SHARP Memory LCD animation')
+    parser.add_argument('-p', '--period', type=int, default=100, help='frame period in ms')
+    parser.add_argument('-n', '--name', default='animation', help='name of array in C header')
+    parser.add_argument('-b', '--binary', action='store_true', help='write binary instead of C header')
+    parser.add_argument('output')
+    parser.add_argument('frames', nargs='+')
+    args = parser.parse_args()
+
+    frames = []
+    size = None
+    for path in args.frames:
+        width, height, rows = read_pbm(path)
+        if size and size != (width, height):
+            sys.exit('%s: all frames must be %dx%d' % (path, size[0], size[1]))
+        size = (width, height)
+        frames.append(rows)
+
+    stride = (size[0] + 7) // 8
+    data, changed = encode(frames, stride, size[1], args.period)
+
+    if args.binary:
+        with open(args.output, 'wb') as f:
+            f.write(data)
+    else:
+        with open(args.output, 'w') as f:
+            f.write('// Animation %dx%dpx, %d frames\n' % (size[0], size[1], len(frames)))
+            f.write('static const unsigned char %s[] =\n{\n' % args.name)
+            for i in range(0, len(data), 12):
+                f.write(' '.join('0x%02x,' % b for b in data[i:i + 12]) + '\n')
+            f.write('};\n')
+
+    # bytes on wire: command and trailer per transaction, address, data and dummy per line
+    naive = len(frames) * (2 + size[1] * (stride + 2))
+    wire = sum(2 + n * (stride + 2) for n in changed if n)
+    print('%d frames, %d bytes encoded (%d bytes raw)' % (len(frames), len(data), len(frames) * stride * size[1]))
+    print('%d lines sent, %d bytes on wire (%d bytes with bitmap)' % (sum(changed), wire, naive))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,259 @@
+#!/usr/bin/env python3
+# Client for the SHARPCoprocessor example, draws on the display over a serial port.
+# Distributed under MIT License, see license.txt for details.
+#
+# usage: sharpcoproc.py [-b baud] port text line [text line ...]
+#        sharpcoproc.py [-b baud] port -i image.pbm [-l line]
+#        sharpcoproc.py [-b baud] port --bench
+#
+# Uses pyserial if installed, otherwise the port is opened as a tty with termios,
+# which also works for pseudo terminals.
+# Commands are batched into frames of up to FRAME_MAX bytes. Each frame is sent after
+# the previous one was acknowledged, frames are repeated on NAK or timeout.
+
+import argparse
+import os
+import time
+
+FRAME_SYNC = 0xA5
+FRAME_MAX = 64
+REPLY_ACK = 0x06
+REPLY_NAK = 0x15
+
+CMD_CLEAR = 0x01
+CMD_TEXT = 0x02
+CMD_FILL = 0x03
+CMD_SCALE = 0x04
+CMD_BITMAP = 0x05
+CMD_INVERT = 0x06
+CMD_ROTATE = 0x07
+CMD_FLUSH = 0x08
+CMD_POWER = 0x09
+
+DISP_INVERT = 1
+DISP_WIDE = 2
+DISP_HIGH = 4
+
+PIXELS_X = 96
+
+
+class TtyPort:
+    """Minimal serial port without pyserial."""
+
+    def __init__(self, path, baud, timeout):
+        import termios
+        import tty
+        self.fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+        tty.setraw(self.fd)
+        attr = termios.tcgetattr(self.fd)
+        speed = getattr(termios, 'B%d' % baud, termios.B9600)
+        attr[4] = attr[5] = speed
+        termios.tcsetattr(self.fd, termios.TCSANOW, attr)
+        self.timeout = timeout
+
+    def write(self, data):
+        os.write(self.fd, data)
+
+    def read(self, size):
+        import select
+        data = b''
+        end = time.time() + self.timeout
+        while len(data) < size:
+            left = end - time.time()
+            if left <= 0 or not select.select([self.fd], [], [], left)[0]:
+                break
+            data += os.read(self.fd, size - len(data))
+        return data
+
+    def close(self):
+        os.close(self.fd)
+
+
+def open_port(path, baud, timeout=1.0):
+    try:
+        import serial
+        return serial.Serial(path, baud, timeout=timeout)
+    except ImportError:
+        return TtyPort(path, baud, timeout)
+
+
+def packbits(data):
+    """Compress bytes with PackBits, as decoded by the coprocessor."""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and run < 128 and data[i + run] == data[i]:
+            run += 1
+        if run > 1:
+            out += bytes([(1 - run) & 0xff, data[i]])
+            i += run
+            continue
+        start = i
+        while i < len(data) and i - start < 128:
+            if i + 1 < len(data) and data[i + 1] == data[i]:
+                break
+            i += 1
+        out.append(i - start - 1)
+        out += data[start:i]
+    return bytes(out)
+
+
+class Coprocessor:
+
+    def __init__(self, port, retries=3):
+        self.port = port
+        self.retries = retries
+        self.seq = 0
+        self.pending = bytearray()
+        self.frames = 0
+        self.resent = 0
+
+    def _command(self, data):
+        if len(data) > FRAME_MAX:
+            raise ValueError('command too long for one frame')
+        if len(self.pending) + len(data) > FRAME_MAX:
+            self.sync()
+        self.pending += data
+
+    def _send(self, payload):
+        check = (self.seq + len(payload) + sum(payload)) & 0xff
+        frame = bytes([FRAME_SYNC, self.seq, len(payload)]) + payload + bytes([check])
+        for attempt in range(self.retries + 1):
+            self.port.write(frame)
+            reply = self.port.read(2)
+            if len(reply) == 2 and reply[0] == REPLY_ACK and reply[1] == self.seq:
+                break
+            if len(reply) == 2 and reply[0] == REPLY_NAK:
+                if self.port.read(1) == b'\x03':
+                    raise IOError('frame %d: invalid command' % self.seq)
+            self.resent += 1
+        else:
+            raise IOError('frame %d: no acknowledge' % self.seq)
+        self.seq = (self.seq + 1) & 0xff
+        self.frames += 1
+
+    def sync(self):
+        """Send batched commands and wait until they were executed."""
+        if self.pending:
+            payload = bytes(self.pending)
+            self.pending = bytearray()
+            self._send(payload)
+
+    def clear(self):
+        self._command(bytes([CMD_CLEAR]))
+
+    def text(self, text, line, options=0):
+        data = text.encode('ascii', 'replace')[:PIXELS_X // 8]
+        self._command(bytes([CMD_TEXT, line, options, len(data)]) + data)
+
+    def fill(self, line, count, pattern=0):
+        self._command(bytes([CMD_FILL, line, count, pattern]))
+
+    def scale(self, x, y):
+        self._command(bytes([CMD_SCALE, x, y]))
+
+    def invert(self, on):
+        self._command(bytes([CMD_INVERT, 1 if on else 0]))
+
+    def rotate(self, rotation):
+        self._command(bytes([CMD_ROTATE, rotation]))
+
+    def flush(self):
+        self._command(bytes([CMD_FLUSH]))
+
+    def power(self, on):
+        self._command(bytes([CMD_POWER, 1 if on else 0]))
+
+    def bitmap(self, data, width, height, line, yscale=1):
+        """Draw bitmap with 1 = black, rows of (width+7)//8 bytes."""
+        stride = (width + 7) // 8
+        rows = [packbits(data[y * stride:(y + 1) * stride]) for y in range(height)]
+        y = 0
+        while y < height:
+            # as many rows as fit into a frame
+            size = 4
+            n = 0
+            while y + n < height and n < 255 and size + len(rows[y + n]) <= FRAME_MAX:
+                size += len(rows[y + n])
+                n += 1
+            self._command(bytes([CMD_BITMAP, line + y * yscale, stride, n]) + b''.join(rows[y:y + n]))
+            y += n
+
+
+def read_pbm(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    tokens = []
+    pos = 0
+    while len(tokens) < 3:
+        while data[pos:pos + 1].isspace():
+            pos += 1
+        if data[pos:pos + 1] == b'#':
+            while data[pos:pos + 1] not in (b'\n', b''):
+                pos += 1
+            continue
+        start = pos
+        while not data[pos:pos + 1].isspace():
+            pos += 1
+        tokens.append(data[start:pos])
+    pos += 1
+
+    if tokens[0] != b'P4':
+        raise ValueError('%s: only binary PBM (P4) is supported' % path)
+    width, height = int(tokens[1]), int(tokens[2])
+    return data[pos:pos + (width + 7) // 8 * height], width, height
+
+
+def bench(lcd):
+    """Measure round trip of single frames and throughput of batched commands."""
+    start = time.time()
+    for i in range(20):
+        lcd.text('%12d' % i, 0)
+        lcd.sync()
+    latency = (time.time() - start) / 20
+
+    start = time.time()
+    frames = lcd.frames
+    for i in range(100):
+        lcd.text('%12d' % i, (i % 12) * 8)
+    lcd.sync()
+    elapsed = time.time() - start
+
+    print('round trip %.1f ms per frame' % (latency * 1000))
+    print('%.0f text commands/s batched into %d frames, %d resent' %
+          (100 / elapsed, lcd.frames - frames, lcd.resent))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Draw on display attached to SHARPCoprocessor')
+    parser.add_argument('port')
+    parser.add_argument('text', nargs='*', help='pairs of text and line')
+    parser.add_argument('-b', '--baud', type=int, default=9600)
+    parser.add_argument('-i', '--image', help='binary PBM image to draw')
+    parser.add_argument('-l', '--line', type=int, default=0, help='first line of image')
+    parser.add_argument('--bench', action='store_true', help='measure latency and throughput')
+    args = parser.parse_intermixed_args()
+
+    lcd = Coprocessor(open_port(args.port, args.baud))
+
+    if args.bench:
+        bench(lcd)
+        return
+
+    if args.image:
+        data, width, height = read_pbm(args.image)
+        lcd.bitmap(data, width, height, args.line)
+
+    if len(args.text) % 2:
+        parser.error('text and line must be given in pairs')
+    for i in range(0, len(args.text), 2):
+        lcd.text(args.text[i], int(args.text[i + 1]))
+
+    lcd.sync()
+    print('%d frames, %d resent' % (lcd.frames, lcd.resent))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,176 @@
+#!/usr/bin/env python3
+# Energy and latency model for display updates, based on traces or a workload script.
+# Distributed under MIT License, see license.txt for details.
+#
+# usage: sharpenergy.py [-b board] [-v] trace.txt
+#        sharpenergy.py [-b board] [-v] --spi [--width pixels] capture.spi
+#        sharpenergy.py [-b board] [-v] -w workload.txt [-s seconds]
+#
+# trace.txt is the output of traceDump(), as read by sharptrace.py. With --spi, the input is a file
+# written by the Linux backend in place of spidev, read with sharptrace.read_spi as by the tests,
+# and SPI runs at the clock recorded in it unless --sclk is given. A workload script describes
+# periodic updates, one per line, to compare update strategies without hardware:
+#
+#   # period_ms  kind      count
+#   1000         lines     8       # write 8 lines in one transfer, e.g. one line of text
+#   1000         transfer  8       # write 8 lines in 8 transfers, e.g. writeBuffer per line
+#   60000        clear             # clear display
+#   500          vcom              # toggle VCOM with a command
+#
+# For each transfer, SPI time, MCU time and energy are estimated from board parameters:
+# the MCU is active while it renders and waits for SPI, and sleeps in between. The panel uses
+# static power plus energy per written line. Prints energy and average power (uJ per second), and
+# with -v each transfer. Board parameters are typical datasheet values at 3 V and estimates for
+# the cycles spent by the library, override them to match your setup.
+
+import argparse
+import os
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import sharptrace
+
+BOARDS = {
+    'g2553': {'name': 'MSP430G2553', 'mhz': 16.0, 'sclk': 1.0, 'active_ma': 4.2, 'sleep_ua': 0.5,
+              'cycles_byte': 40, 'cycles_line': 400, 'cycles_transfer': 150},
+    'f5529': {'name': 'MSP430F5529', 'mhz': 25.0, 'sclk': 1.0, 'active_ma': 8.9, 'sleep_ua': 1.9,
+              'cycles_byte': 40, 'cycles_line': 400, 'cycles_transfer': 150},
+    'tiva': {'name': 'TM4C123', 'mhz': 80.0, 'sclk': 1.0, 'active_ma': 45.0, 'sleep_ua': 1000.0,
+             'cycles_byte': 60, 'cycles_line': 300, 'cycles_transfer': 200},
+}
+
+VOLT = 3.0
+PANEL_STATIC_UW = 5.0                           # LS013B4DN04, static display
+PANEL_LINE_UJ = 0.47                            # derived from 50 uW typical with full update at 1 Hz
+
+
+class Model:
+
+    def __init__(self, board, width):
+        self.board = board
+        self.width = width
+
+    def transfer(self, t):
+        """Returns SPI time, MCU active time (both us) and MCU energy (uJ) of transfer."""
+        b = self.board
+        if t.cmd & sharptrace.TRACE_EXTCOMIN:   # pin toggle, a few cycles
+            spi = 0.0
+            cycles = b['cycles_transfer']
+        else:
+            nbytes = t.wire_bytes(self.width)
+            spi = nbytes * 8 / b['sclk']
+            cycles = b['cycles_transfer'] + nbytes * b['cycles_byte'] + len(t.lines) * b['cycles_line']
+        active = spi + cycles / b['mhz']        # MCU polls SPI, each byte is prepared after previous one was sent
+        energy = VOLT * b['active_ma'] * active / 1000
+        return spi, active, energy
+
+    def panel(self, t):
+        return len(t.lines) * PANEL_LINE_UJ
+
+
+def workload(path, seconds):
+    """Returns records for periodic updates described in workload script."""
+    records = []
+    with open(path) as f:
+        for number, text in enumerate(f, 1):
+            fields = text.split('#')[0].split()
+            if not fields:
+                continue
+            try:
+                period = int(fields[0])
+                kind = fields[1]
+                count = int(fields[2]) if len(fields) > 2 else 1
+            except (ValueError, IndexError):
+                sys.exit('%s:%d: expected period, kind and count' % (path, number))
+            if period <= 0 or kind not in ('lines', 'transfer', 'clear', 'vcom'):
+                sys.exit('%s:%d: invalid update' % (path, number))
+
+            vcom = 0
+            for time in range(0, seconds * 1000, period):
+                if kind == 'clear':
+                    records.append(sharptrace.Record(time, sharptrace.CMD_CLR, 0, 0))
+                elif kind == 'vcom':
+                    vcom ^= sharptrace.CMD_VCOM
+                    records.append(sharptrace.Record(time, vcom, 0, 0))
+                else:
+                    for i in range(count):
+                        start = sharptrace.TRACE_START if kind == 'transfer' or i == 0 else 0
+                        records.append(sharptrace.Record(time, sharptrace.CMD_WR | start, i + 1, 0))
+
+    records.sort(key=lambda r: r.time)          # stable, lines of a transfer stay together
+    return records
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Estimate energy and latency of display updates')
+    parser.add_argument('trace', nargs='?', help='output of traceDump, or SPI file with --spi')
+    parser.add_argument('--spi', action='store_true', help='bytes sent by Linux backend to file')
+    parser.add_argument('--width', type=int, default=96, help='display width of SPI file')
+    parser.add_argument('-w', '--workload', help='workload script instead of trace')
+    parser.add_argument('-s', '--seconds', type=int, default=10, help='duration of workload')
+    parser.add_argument('-b', '--board', choices=sorted(BOARDS), default='g2553')
+    parser.add_argument('-v', '--verbose', action='store_true', help='print each transfer')
+    for key in ('mhz', 'sclk', 'active_ma', 'sleep_ua', 'cycles_byte', 'cycles_line', 'cycles_transfer'):
+        parser.add_argument('--' + key.replace('_', '-'), type=float, help='override board parameter')
+    args = parser.parse_args()
+
+    board = dict(BOARDS[args.board])
+    for key in board:
+        value = getattr(args, key, None)
+        if value is not None:
+            board[key] = value
+
+    width = 96
+    if args.workload:
+        records = workload(args.workload, args.seconds)
+    elif args.trace and args.spi:
+        width = args.width
+        records = sharptrace.read_spi(args.trace, width)
+        speed = sharptrace.read_bursts(args.trace)[0]
+        if speed and args.sclk is None:
+            board['sclk'] = speed / 1e6
+    elif args.trace:
+        records, width, height = sharptrace.read_text(args.trace)
+    else:
+        parser.error('trace or workload required')
+    if not records:
+        sys.exit('no updates found')
+
+    model = Model(board, width)
+    start = records[0].time
+    end = max(records[-1].time + 1, start + args.seconds * 1000 if args.workload else 0)
+    duration = (end - start) / 1000.0           # seconds
+
+    spi_total = active_total = mcu_total = panel_total = 0.0
+    latency_max = 0.0
+    transfers = sharptrace.transfers(records)
+
+    if args.verbose:
+        print('time_ms  lines  bytes  spi_us  latency_us  energy_uJ')
+    for t in transfers:
+        spi, active, energy = model.transfer(t)
+        panel = model.panel(t)
+        spi_total += spi
+        active_total += active
+        mcu_total += energy
+        panel_total += panel
+        latency_max = max(latency_max, active)
+        if args.verbose:
+            print('%7d  %5d  %5d  %6.0f  %10.0f  %9.2f' % (t.time, len(t.lines), t.wire_bytes(width),
+                                                           spi, active, energy + panel))
+
+    sleep = VOLT * board['sleep_ua'] * max(0.0, duration - active_total / 1e6)
+    panel_total += PANEL_STATIC_UW * duration
+    total = mcu_total + sleep + panel_total
+
+    print('%s at %g MHz, SPI at %g MHz, %.1f s, %d transfers' %
+          (board['name'], board['mhz'], board['sclk'], duration, len(transfers)))
+    print('MCU active  %10.1f uJ  (%.1f ms, SPI %.1f ms)' % (mcu_total, active_total / 1000, spi_total / 1000))
+    print('MCU sleep   %10.1f uJ' % sleep)
+    print('panel       %10.1f uJ' % panel_total)
+    print('total       %10.1f uJ, %.1f uW average' % (total, total / duration))
+    print('latency     %10.0f us maximum per transfer' % latency_max)
+
+
+if __name__ == '__main__':
+    main()
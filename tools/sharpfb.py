@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+# Client for the shared frame buffer of linux/sharpfbd, draws on the display without linking the library.
+# Distributed under MIT License, see license.txt for details.
+#
+# usage: sharpfb.py [-f file] [-w] image.pbm [line]
+#        sharpfb.py [-f file] [-w] --clear
+#        sharpfb.py [-f file] --bench [-n frames]
+#
+# Copies a PBM image into the frame buffer and marks the lines that changed. With -w, waits until
+# sharpfbd sent an update after that, or for 5 seconds and fails. --bench draws a
+# moving bar as fast as possible and prints how many of these frames the daemon sent, as changes
+# between two updates of the daemon are combined.
+
+import argparse
+import mmap
+import os
+import struct
+import sys
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import sharpcoproc
+
+SHARPFB_MAGIC = 0x42464853
+HEADER = '<IHHII32s'                            # see linux/sharpfb.h
+HEADER_SIZE = struct.calcsize(HEADER)
+FRAMES = 8                                      # offset of frames
+DIRTY = 16                                      # offset of dirty
+
+
+class Framebuffer:
+
+    def __init__(self, path):
+        fd = os.open(path, os.O_RDWR)
+        self.map = mmap.mmap(fd, 0)
+        os.close(fd)
+        magic, self.width, self.height = struct.unpack_from('<IHH', self.map, 0)
+        if magic != SHARPFB_MAGIC:
+            raise ValueError('%s: not a frame buffer of sharpfbd' % path)
+        self.stride = self.width // 8
+        self.changed = set()
+
+    def frames(self):
+        return struct.unpack_from('<I', self.map, FRAMES)[0]
+
+    def write(self, line, data):
+        """Writes one line of pixels in display format, remembers it for mark if it changed."""
+        pos = HEADER_SIZE + line * self.stride
+        if self.map[pos:pos + self.stride] != data:
+            self.map[pos:pos + self.stride] = data
+            self.changed.add(line)
+
+    def mark(self):
+        """Marks the lines written since the last call, once all of them hold their pixels, so an
+        update of sharpfbd doesn't send half of a drawing."""
+        for line in self.changed:
+            self.map[DIRTY + line // 8] |= 1 << (line & 7)  # not atomic, sharpfbd only clears marks
+        self.changed.clear()
+
+
+def draw(fb, pixels, width, height, line):
+    stride = (width + 7) // 8
+    for y in range(height):
+        if not 0 <= line + y < fb.height:
+            continue
+        row = bytearray(b'\xff' * fb.stride)
+        for x in range(min(stride, fb.stride)):
+            row[x] = pixels[y * stride + x] ^ 0xff  # PBM is 1 for black, display is 1 for white
+        if width & 7 and stride <= fb.stride:
+            row[stride - 1] |= 0xff >> (width & 7)
+        fb.write(line + y, bytes(row))
+    fb.mark()
+
+
+def bench(fb, count):
+    start_frames = fb.frames()
+    start = time.time()
+    for i in range(count):
+        for y in range(fb.height):
+            fb.write(y, b'\x00' * fb.stride if (y - i) % fb.height < 8 else b'\xff' * fb.stride)
+        fb.mark()
+    elapsed = time.time() - start
+    time.sleep(0.2)                             # wait for last update
+    sent = fb.frames() - start_frames
+    print('%d frames in %.2f s, %.0f frames/s, %d updates sent by sharpfbd' %
+          (count, elapsed, count / elapsed, sent))
+
+
+def wait(fb, frames, timeout=5.0):
+    """Returns True once sharpfbd counted an update since frames, False after timeout seconds."""
+    end = time.time() + timeout
+    while fb.frames() == frames:
+        if time.time() > end:
+            return False
+        time.sleep(0.005)
+    return True
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Draw into shared frame buffer of sharpfbd')
+    parser.add_argument('image', nargs='?', help='PBM image')
+    parser.add_argument('line', nargs='?', type=int, default=0, help='first line of image')
+    parser.add_argument('-f', '--file', default='/dev/shm/sharpfb', help='frame buffer file')
+    parser.add_argument('-w', '--wait', action='store_true', help='wait until the change was sent')
+    parser.add_argument('--clear', action='store_true', help='clear display')
+    parser.add_argument('--bench', action='store_true', help='measure frame rate of client and daemon')
+    parser.add_argument('-n', '--frames', type=int, default=1000, help='frames drawn by --bench')
+    args = parser.parse_args()
+
+    try:
+        fb = Framebuffer(args.file)
+    except (OSError, ValueError) as e:
+        sys.exit(str(e))
+
+    frames = fb.frames()                        # before drawing, so an update in between is not missed
+    if args.clear:
+        for y in range(fb.height):
+            fb.write(y, b'\xff' * fb.stride)
+        fb.mark()
+    elif args.bench:
+        bench(fb, args.frames)
+        return
+    elif args.image:
+        pixels, width, height = sharpcoproc.read_pbm(args.image)
+        draw(fb, pixels, width, height, args.line)
+    else:
+        parser.error('image, --clear or --bench required')
+    if args.wait and not wait(fb, frames):
+        sys.exit('%s: no update of sharpfbd' % args.file)
+
+
+if __name__ == '__main__':
+    main()
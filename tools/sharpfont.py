@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+# Generates a header that limits the font to the characters an application uses.
+# Distributed under MIT License, see license.txt for details.
+#
+# usage: sharpfont.py [-c charset] [-o fontset.h] [source...]
+#
+# Collects the characters of all string literals in the sources, e.g. main.c or a sketch, and of
+# charset, for text built at run time like digits of a clock. Strings with printf conversions
+# add the characters they can print. Include the header before font.h, in SHARPMemLCDConfig.h
+# for the Energia library, and only the glyphs of these characters are in the font. Other
+# characters are shown blank. Prints the characters and the flash saved by the font tables.
+
+import argparse
+import re
+import sys
+
+FIRST = ord(' ')                                # range of font.h
+LAST = ord('Z')
+
+CONVERSIONS = {                                 # characters printed by printf conversions
+    'd': '-0123456789.', 'i': '-0123456789.', 'u': '0123456789.',
+    'x': '0123456789ABCDEF', 'X': '0123456789ABCDEF',
+}
+
+
+def strings(source):
+    """Returns contents of string literals, without comments and #include lines."""
+    found = []
+    i = 0
+    while i < len(source):
+        if source.startswith('//', i):
+            i = source.find('\n', i)
+        elif source.startswith('/*', i):
+            i = source.find('*/', i) + 2
+        elif source.startswith('#include', i):
+            i = source.find('\n', i)
+        elif source[i] == "'":                  # skip character literals, e.g. '"'
+            m = re.match(r"'(\\.|[^'\\])*'", source[i:])
+            i += len(m.group(0)) if m else 1
+        elif source[i] == '"':
+            m = re.match(r'"((?:\\.|[^"\\])*)"', source[i:])
+            if not m:
+                i += 1
+                continue
+            found.append(bytes(m.group(1), 'ascii', 'replace').decode('unicode_escape'))
+            i += len(m.group(0))
+        else:
+            i += 1
+        if i < 0:
+            break
+    return found
+
+
+def charset(texts):
+    chars = set(' ')                            # invalid characters are shown as SPACE
+    for text in texts:
+        chars.update(text)
+        for conversion in re.findall(r'%[-0-9.l]*([a-zA-Z%])', text):
+            chars.update(CONVERSIONS.get(conversion, ''))
+    return sorted(c for c in chars if FIRST <= ord(c) <= LAST)
+
+
+def header(chars, sources):
+    codes = [ord(c) for c in chars]
+    first, last = codes[0], codes[-1]
+    index = [codes.index(c) if c in codes else len(codes) for c in range(first, last + 1)]
+
+    lines = ['// Glyphs used by %s, generated by tools/sharpfont.py.' % (', '.join(sources) or 'charset'),
+             '// Characters: %s' % ''.join(chars),
+             '',
+             '#define SHARP_FONT_FIRST %d' % first,
+             '#define SHARP_FONT_LAST %d' % last,
+             '#define SHARP_FONT_GLYPHS %d' % len(codes)]
+    lines += ['#define SHARP_FONT_HAS_%d 1' % c for c in codes]
+    lines.append('#define SHARP_FONT_INDEX %s' % ', '.join(str(n) for n in index))
+    return '\n'.join(lines) + '\n'
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate font subset header from used characters')
+    parser.add_argument('source', nargs='*', help='C, C++ or sketch files to collect strings from')
+    parser.add_argument('-c', '--charset', default='', help='characters to include in addition')
+    parser.add_argument('-o', '--output', help='header to write, default is standard output')
+    args = parser.parse_args()
+
+    texts = [args.charset]
+    for path in args.source:
+        with open(path, encoding='latin-1') as f:
+            texts += strings(f.read())
+
+    chars = charset(texts)
+    text = header(chars, args.source)
+    if args.output:
+        with open(args.output, 'w') as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+
+    saved = (LAST - FIRST + 1 - len(chars)) * 8
+    sys.stderr.write('%d of %d glyphs: %s\n' % (len(chars), LAST - FIRST + 1, ''.join(chars)))
+    sys.stderr.write('font8x8 %d bytes smaller, fontIndex %d bytes\n' % (saved, ord(chars[-1]) - ord(chars[0]) + 1))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+# Cycle counts and code size of the render path of main.c, run under the MSP430 simulator of mspdebug.
+# Distributed under MIT License, see license.txt for details.
+#
+# usage: sharpprofile.py [-r results.csv] [-n note] firmware.elf [firmware.elf ...]
+#
+# Each firmware is main.c built by msp430-elf-gcc with PROFILE defined, see make profile. It is
+# loaded into mspdebug sim with a simulated timer A1, and run until profileDone, when profileCycles
+# holds the cycles of each measurement. Timer A1 counts SMCLK, which the simulator clocks with MCLK.
+# The simulated USCI is expected never to be busy, so the cycles are those of the CPU, without
+# waiting for SPI. Experimental: this has not been verified against mspdebug, see README.md.
+#
+# Prints cycles without the cost of the measurement, and code size per function from
+# msp430-elf-nm. With -r, a row per firmware is appended to the results file, with date, commit
+# and note, and the change to the last row of that firmware in the file is shown, so the effect of
+# an optimization stays on record.
+
+import argparse
+import csv
+import datetime
+import os
+import re
+import subprocess
+import sys
+
+MEASUREMENTS = ['overhead', 'SPIWriteByte', 'SPIWriteLine', 'doubleWideAsm'] + \
+               ['printSharp%d' % options for options in range(8)]
+FUNCTIONS = ['SPIWriteByte', 'SPIWriteWord', 'SPIWriteLine', 'doubleWideAsm', 'printSharp']
+COLUMNS = ['date', 'commit', 'firmware', 'note'] + MEASUREMENTS[1:] + \
+          ['size_' + f for f in FUNCTIONS] + ['text', 'data', 'bss']
+
+TA1_BASE = 0x180                                # TA1CTL, TA1R is at base + 0x10
+TA1_IV = 0x11e
+
+
+def symbols(elf, prefix):
+    """Returns address and size of each symbol."""
+    out = subprocess.run([prefix + 'nm', '-S', elf], stdout=subprocess.PIPE, check=True,
+                         universal_newlines=True).stdout
+    table = {}
+    for line in out.splitlines():
+        fields = line.split()
+        if len(fields) == 4:
+            table[fields[3]] = (int(fields[0], 16), int(fields[1], 16))
+        elif len(fields) == 3:                  # no size, e.g. assembly without .size
+            table[fields[2]] = (int(fields[0], 16), 0)
+    return table
+
+
+def sections(elf, prefix):
+    out = subprocess.run([prefix + 'size', elf], stdout=subprocess.PIPE, check=True,
+                         universal_newlines=True).stdout
+    text, data, bss = out.splitlines()[1].split()[:3]
+    return int(text), int(data), int(bss)
+
+
+def simulate(elf, address, count):
+    """Runs firmware until profileDone, returns count words of memory at address."""
+    commands = ['prog %s' % elf,
+                'simio add timer ta1',
+                'simio config ta1 base 0x%x' % TA1_BASE,
+                'simio config ta1 iv 0x%x' % TA1_IV,
+                'setbreak profileDone',
+                'run',
+                'md 0x%x %d' % (address, count * 2)]
+    out = subprocess.run(['mspdebug', '-q', 'sim'] + commands, stdout=subprocess.PIPE,
+                         stderr=subprocess.STDOUT, universal_newlines=True, timeout=60).stdout
+
+    data = bytearray()
+    for line in out.splitlines():               # e.g. "    00200: 1e 00 34 00 ... |..4.|"
+        m = re.match(r'\s*([0-9a-f]+):\s+((?:[0-9a-f]{2} +)+)', line)
+        if m and int(m.group(1), 16) == address + len(data):
+            data += bytes(int(b, 16) for b in m.group(2).split())
+    if len(data) < count * 2:
+        raise RuntimeError('%s: profileDone not reached in simulator\n%s' % (elf, out))
+    return [data[i] | data[i + 1] << 8 for i in range(0, count * 2, 2)]
+
+
+def commit():
+    try:
+        return subprocess.run(['git', 'rev-parse', '--short', 'HEAD'], stdout=subprocess.PIPE,
+                              universal_newlines=True).stdout.strip()
+    except OSError:
+        return ''
+
+
+def profile(elf, prefix, note):
+    table = symbols(elf, prefix)
+    if 'profileCycles' not in table or 'profileDone' not in table:
+        raise RuntimeError('%s: not built with PROFILE' % elf)
+
+    cycles = simulate(elf, table['profileCycles'][0], len(MEASUREMENTS))
+    row = {'date': datetime.date.today().isoformat(), 'commit': commit(),
+           'firmware': os.path.splitext(os.path.basename(elf))[0], 'note': note}
+    for name, value in zip(MEASUREMENTS[1:], cycles[1:]):
+        row[name] = value - cycles[0]
+    for f in FUNCTIONS:
+        row['size_' + f] = table.get(f, (0, 0))[1]
+    row['text'], row['data'], row['bss'] = sections(elf, prefix)
+    return row
+
+
+def last_row(path, firmware):
+    last = None
+    if os.path.exists(path):
+        with open(path) as f:
+            for row in csv.DictReader(f):
+                if row['firmware'] == firmware:
+                    last = row
+    return last
+
+
+def report(row, previous):
+    print('%s (%s)' % (row['firmware'], row['commit']))
+    for name in COLUMNS[4:]:
+        change = ''
+        if previous and previous.get(name):
+            diff = row[name] - int(previous[name])
+            if diff:
+                change = ' %+d since %s' % (diff, previous['commit'])
+        print('  %-20s %6d%s' % (name, row[name], change))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Profile main.c under the MSP430 simulator')
+    parser.add_argument('elf', nargs='+', help='firmware built with PROFILE')
+    parser.add_argument('-r', '--results', help='CSV file to append results to')
+    parser.add_argument('-n', '--note', default='', help='note for the results, e.g. what changed')
+    parser.add_argument('--prefix', default='msp430-elf-', help='prefix of binutils')
+    args = parser.parse_args()
+
+    rows = []
+    for elf in args.elf:
+        try:
+            row = profile(elf, args.prefix, args.note)
+        except (OSError, RuntimeError, subprocess.SubprocessError) as e:
+            sys.exit(str(e))
+        report(row, last_row(args.results, row['firmware']) if args.results else None)
+        rows.append(row)
+
+    if args.results:
+        new = not os.path.exists(args.results) or os.path.getsize(args.results) == 0
+        with open(args.results, 'a', newline='') as f:
+            writer = csv.DictWriter(f, COLUMNS)
+            if new:
+                writer.writeheader()
+            writer.writerows(rows)
+
+
+if __name__ == '__main__':
+    main()
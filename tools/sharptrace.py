@@ -0,0 +1,494 @@
+#!/usr/bin/env python3
+# Decoder for traces of what was sent to the display, recorded with SHARP_TRACE.
+# Distributed under MIT License, see license.txt for details.
+#
+# usage: sharptrace.py [-o prefix] trace.txt
+#        sharptrace.py --binary [--data] [-o prefix] sharptrace.bin
+#        sharptrace.py --spi [--gpio log --cs pin [--extract out.spi]] [-o prefix] capture.spi
+#
+# trace.txt is the output of traceDump() of the Energia library. Other lines are ignored, so a
+# complete serial log can be decoded. With --binary, the input is a memory dump of sharpTrace
+# of main.c, with --data if it was built with SHARP_TRACE_DATA. With --spi, the input is a file written
+# by the Linux backend in place of spidev, which holds all bytes sent and therefore all line data.
+# With --gpio, log is the file the backend wrote in place of a GPIO chip, and only bursts sent while
+# chip select on line --cs was high are decoded, e.g. of one of several panels sharing a bus.
+# --extract writes them as SPI file of their own. A line requested again before it was released,
+# or changed without request, is an error, as the kernel would have refused the request.
+#
+# Prints transfers, lines, bytes on the wire and VCOM toggles per second.
+# With -o, reconstructed frames are written as prefix0000.pbm, prefix0001.pbm, ..., one for each
+# transfer that changed the display. This requires line data recorded with SHARP_TRACE_DATA.
+# The trace only holds the latest records, lines not written since its start are shown white.
+#
+# With --check, the trace is checked against the rules of the panel and the exit code is 1 on
+# violations: valid commands and line addresses, VCOM inverted at least every --vcom-max and at
+# most every --vcom-min milliseconds, and DC bias per pixel. DC bias is the time a pixel was
+# black with VCOM high minus the time it was black with VCOM low. It stays small while VCOM
+# alternates and grows when it doesn't. Lines without recorded data count as black.
+# --bias-map writes the peak DC bias of each pixel as PGM image.
+# With --spi, each burst is also checked to hold a command and trailer, or whole lines and trailer,
+# and the SPI clock recorded by the backend not to exceed --sclk-max. Timing of SCS setup and hold
+# is not part of any trace and needs a logic analyzer.
+
+import argparse
+import struct
+import sys
+
+CMD_WR = 0x01
+CMD_VCOM = 0x02
+CMD_CLR = 0x04
+TRACE_START = 0x40
+TRACE_EXTCOMIN = 0x80
+
+VCOM_MIN = 16                                   # defaults of --check, in ms
+VCOM_MAX = 2000
+BIAS_MAX = 2000
+SCLK_MAX = 1000000                              # in Hz, as specified by the panel
+
+
+class Record:
+
+    def __init__(self, time, cmd, line, hash, data=None):
+        self.time = time
+        self.cmd = cmd
+        self.line = line
+        self.hash = hash
+        self.data = data
+
+
+class Transfer:
+    """Records sent with chip select high, a command or a write of consecutive lines."""
+
+    def __init__(self, record):
+        self.time = record.time
+        self.cmd = record.cmd & ~TRACE_START
+        self.lines = []
+        if record.line:
+            self.lines.append(record)
+
+    def wire_bytes(self, width):
+        if self.cmd & TRACE_EXTCOMIN:
+            return 0
+        if self.lines:
+            return 2 + len(self.lines) * (2 + width // 8)
+        return 2
+
+
+def read_text(path):
+    """Returns records and display size from output of traceDump."""
+    records = []
+    width, height = 96, 96
+    with open(path) as f:
+        for text in f:
+            fields = text.split()
+            if fields[:3] == ['#', 'SHARP', 'trace'] and len(fields) >= 6:
+                width, height = int(fields[4]), int(fields[5])
+            if len(fields) < 5 or fields[0] != 'T':
+                continue
+            try:
+                data = bytes.fromhex(fields[5]) if len(fields) > 5 else None
+                records.append(Record(int(fields[1]), int(fields[2], 16), int(fields[3], 16),
+                                      int(fields[4], 16), data))
+            except ValueError:
+                pass                            # garbled line in serial log
+    return records, width, height
+
+
+def read_binary(path, data, width):
+    """Returns records from memory dump of sharpTrace in main.c, MSP430 byte order."""
+    with open(path, 'rb') as f:
+        raw = f.read()
+
+    count, next = struct.unpack_from('<HB', raw, 0)
+    size = 8 + (width // 8 if data else 0)
+    slots = (len(raw) - 4) // size
+
+    records = []
+    for i in range(slots):
+        time, cmd, line, hash = struct.unpack_from('<IBBH', raw, 4 + i * size)
+        pixels = raw[4 + i * size + 8:4 + (i + 1) * size] if data else None
+        records.append(Record(time, cmd, line, hash, pixels if line else None))
+
+    if count < slots:                           # ring buffer not filled yet
+        return records[:count]
+    return records[next:] + records[:next]
+
+
+SPI_SPEED = 0xffffffff                          # time of record holding the SPI clock
+SPI_CONTINUED = 0x8000                          # flag in length, burst continues in next record
+
+
+def read_bursts(path):
+    """Returns SPI clock in Hz (0 if unknown) and bursts of a file written by the Linux backend,
+    see linux/SHARPLinux.h. A burst is a tuple of time and bytes, or None for a pulse on EXTCOMIN."""
+    with open(path, 'rb') as f:
+        raw = f.read()
+
+    speed = 0
+    bursts = []
+    pending = None                              # burst continued in next record
+    pos = 0
+    while pos + 6 <= len(raw):
+        time, length = struct.unpack_from('<IH', raw, pos)
+        pos += 6
+        data = raw[pos:pos + (length & ~SPI_CONTINUED)]
+        pos += len(data)
+        if time == SPI_SPEED and len(data) == 4:
+            speed = struct.unpack('<I', data)[0]
+        elif pending:
+            pending = (pending[0], pending[1] + data)
+        elif length == 0:
+            bursts.append((time, None))
+        else:
+            pending = (time, data)
+        if pending and not length & SPI_CONTINUED:
+            bursts.append(pending)
+            pending = None
+    if pending:
+        bursts.append(pending)
+    return speed, bursts
+
+
+def read_gpio(path, errors):
+    """Returns events of GPIO lines logged by the Linux backend to a file in place of the GPIO
+    chip, see linux/SHARPLinux.h, as tuples of bursts before, event, pin and value. A request of a
+    line that is held, or a change or release of a line that is not, is appended to errors."""
+    events = []
+    held = set()
+    with open(path) as f:
+        for number, text in enumerate(f, 1):
+            fields = text.split()
+            try:
+                count, event, pin = int(fields[0]), fields[1], int(fields[2])
+                value = int(fields[3]) if event == 'set' else None
+            except (ValueError, IndexError):
+                errors.append('%s:%d: expected bursts, event and pin' % (path, number))
+                continue
+            if event == 'request' and pin in held:
+                errors.append('%s:%d: line %d requested again' % (path, number, pin))
+            elif event in ('set', 'release') and pin not in held:
+                errors.append('%s:%d: line %d not requested' % (path, number, pin))
+            if event == 'request':
+                held.add(pin)
+            elif event == 'release':
+                held.discard(pin)
+            events.append((count, event, pin, value))
+    return events
+
+
+def select_bursts(bursts, events, pin):
+    """Returns the bursts sent while line pin was high, and all pulses on EXTCOMIN. An event after
+    n bursts happened before burst n."""
+    changes = [(count, value) for count, event, p, value in events if event == 'set' and p == pin]
+    selected = []
+    high = 0
+    n = 0
+    for burst in bursts:
+        if burst[1] is None:
+            selected.append(burst)
+            continue
+        while changes and changes[0][0] <= n:
+            high = changes.pop(0)[1]
+        if high:
+            selected.append(burst)
+        n += 1
+    return selected
+
+
+def write_bursts(path, speed, bursts):
+    """Writes bursts as file of the Linux backend, as read by read_bursts."""
+    with open(path, 'wb') as f:
+        f.write(struct.pack('<IHI', SPI_SPEED, 4, speed))
+        for time, data in bursts:
+            data = data or b''
+            pos = 0
+            while True:                         # records of at most 0x7fff bytes
+                n = min(len(data) - pos, SPI_CONTINUED - 1)
+                more = pos + n < len(data)
+                f.write(struct.pack('<IH', time, n | (SPI_CONTINUED if more else 0)) + data[pos:pos + n])
+                pos += n
+                if not more:
+                    break
+
+
+def read_spi(path, width, errors=None, sclk_max=0, gpio=None, cs=None):
+    """Returns records from bytes sent to a file by the Linux backend, see linux/SHARPLinux.h.
+    Each burst is decoded on its own. Errors below command level, a burst of wrong length, e.g.
+    without trailer or truncated in a line, and an SPI clock above sclk_max, are appended to errors.
+    With gpio, the log of the GPIO chip, only bursts sent while line cs was high are decoded."""
+    if errors is None:
+        errors = []
+    speed, bursts = read_bursts(path)
+    if gpio:
+        bursts = select_bursts(bursts, read_gpio(gpio, errors), cs)
+    stride = width // 8
+    if sclk_max and speed > sclk_max:
+        errors.append('SCLK %d Hz above %d Hz' % (speed, sclk_max))
+
+    def rev(b):                                 # command and address are sent LSB first
+        return int('{:08b}'.format(b)[::-1], 2)
+
+    records = []
+    for time, data in bursts:
+        if data is None:
+            records.append(Record(time, TRACE_EXTCOMIN, 0, 0))
+            continue
+
+        cmd = rev(data[0])
+        if not cmd & CMD_WR:                    # command and trailer
+            records.append(Record(time, cmd, 0, 0))
+            if len(data) != 2:
+                errors.append('%d ms: command %02x in burst of %d bytes instead of 2' % (time, cmd, len(data)))
+            continue
+
+        if len(data) < stride + 4 or (len(data) - 2) % (stride + 2):
+            errors.append('%d ms: write of %d bytes, not lines of %d bytes and trailer, e.g. truncated' %
+                          (time, len(data), stride + 2))
+        start = TRACE_START
+        pos = 1
+        while pos + stride + 2 <= len(data):    # address, data and dummy byte of each complete line
+            records.append(Record(time, cmd | start, rev(data[pos]), 0, bytes(data[pos + 1:pos + 1 + stride])))
+            start = 0
+            pos += stride + 2
+    return records
+
+
+def transfers(records):
+    result = []
+    for r in records:
+        if r.line and not r.cmd & TRACE_START and result and result[-1].lines:
+            result[-1].lines.append(r)          # next line of same transfer
+        else:
+            result.append(Transfer(r))
+    return result
+
+
+def vcom_toggles(records):
+    """Returns times at which VCOM changed, by VCOM bit of commands or EXTCOMIN pulses."""
+    times = []
+    state = None
+    for r in records:
+        if r.cmd & TRACE_EXTCOMIN:
+            times.append(r.time)
+            continue
+        vcom = r.cmd & CMD_VCOM
+        if state is not None and vcom != state:
+            times.append(r.time)
+        state = vcom
+    return times
+
+
+def vcom_states(records):
+    """Returns VCOM state after each record, EXTCOMIN pulses invert the previous state."""
+    states = []
+    state = 0
+    for r in records:
+        if r.cmd & TRACE_EXTCOMIN:
+            state ^= 1
+        else:
+            state = 1 if r.cmd & CMD_VCOM else 0
+        states.append(state)
+    return states
+
+
+def dc_bias(records, width, height):
+    """Returns peak DC bias of each pixel in milliseconds."""
+    bias = [[0] * width for _ in range(height)]
+    peak = [[0] * width for _ in range(height)]
+    lines = [None] * height                     # line data as sent, None if unknown
+    since = [records[0].time] * height
+    states = vcom_states(records)
+    vcom = states[0]
+
+    def settle(y, now):
+        dt = now - since[y]
+        since[y] = now
+        if dt <= 0:
+            return
+        step = dt if vcom else -dt
+        row, b, p = lines[y], bias[y], peak[y]
+        for x in range(width):
+            if row is None or not row[x >> 3] & (0x80 >> (x & 7)):   # pixels are LOW active
+                b[x] += step
+                if abs(b[x]) > p[x]:
+                    p[x] = abs(b[x])
+
+    for r, state in zip(records, states):
+        if state != vcom:
+            for y in range(height):
+                settle(y, r.time)
+            vcom = state
+        if r.cmd & CMD_CLR and not r.cmd & TRACE_EXTCOMIN:
+            for y in range(height):
+                settle(y, r.time)
+            lines = [b'\xff' * (width // 8)] * height
+        if 1 <= r.line <= height:
+            settle(r.line - 1, r.time)
+            lines[r.line - 1] = r.data
+
+    for y in range(height):
+        settle(y, records[-1].time)
+
+    return peak
+
+
+def violations(records, width, height, vcom_min=VCOM_MIN, vcom_max=VCOM_MAX, bias_max=BIAS_MAX, errors=None):
+    """Returns violations of panel rules after errors found while reading the trace, number of VCOM
+    inversions and peak DC bias of each pixel."""
+    errors = list(errors or [])
+
+    for r in records:
+        if r.cmd & TRACE_EXTCOMIN:
+            continue
+        cmd = r.cmd & ~TRACE_START
+        if cmd & ~(CMD_WR | CMD_VCOM | CMD_CLR) or (cmd & CMD_WR and cmd & CMD_CLR):
+            errors.append('%d ms: invalid command %02x' % (r.time, cmd))
+        if r.line and (not cmd & CMD_WR or r.line > height):
+            errors.append('%d ms: invalid line address %d' % (r.time, r.line))
+        if cmd & CMD_WR and not r.line:
+            errors.append('%d ms: write without line' % r.time)
+
+    toggles = vcom_toggles(records)
+    last = records[0].time
+    for time in toggles + [records[-1].time]:
+        if time - last > vcom_max:
+            errors.append('%d ms: VCOM not inverted for %d ms' % (time, time - last))
+        last = time
+    for a, b in zip(toggles, toggles[1:]):
+        if b - a < vcom_min:
+            errors.append('%d ms: VCOM inverted after %d ms' % (b, b - a))
+
+    peak = dc_bias(records, width, height)
+    worst = max(max(row) for row in peak)
+    over = sum(1 for row in peak for p in row if p > bias_max)
+    if over:
+        errors.append('DC bias of %d pixels above %d ms, peak %d ms' % (over, bias_max, worst))
+
+    return errors, len(toggles), peak
+
+
+def check(records, width, height, vcom_min, vcom_max, bias_max, bias_map=None, errors=None):
+    """Prints violations of panel rules and errors found while reading the trace, returns their number."""
+    errors, toggles, peak = violations(records, width, height, vcom_min, vcom_max, bias_max, errors)
+    worst = max(max(row) for row in peak)
+
+    if bias_map:
+        with open(bias_map, 'wb') as f:
+            f.write(b'P5\n%d %d\n255\n' % (width, height))
+            for row in peak:
+                f.write(bytes(min(255, p * 255 // max(worst, 1)) for p in row))
+
+    for e in errors:
+        print(e)
+    print('%d violations, %d VCOM inversions, peak DC bias %d ms' % (len(errors), toggles, worst))
+    return len(errors)
+
+
+def profile(records, width):
+    """Prints traffic per second."""
+    seconds = {}
+    for t in transfers(records):
+        s = seconds.setdefault(t.time // 1000, [0, 0, 0, 0])
+        s[0] += 1
+        s[1] += len(t.lines)
+        s[2] += t.wire_bytes(width)
+    for time in vcom_toggles(records):
+        seconds.setdefault(time // 1000, [0, 0, 0, 0])[3] += 1
+
+    print('second  transfers  lines  bytes  vcom')
+    for second in sorted(seconds):
+        s = seconds[second]
+        print('%6d  %9d  %5d  %5d  %4d' % (second, s[0], s[1], s[2], s[3]))
+
+    total = [sum(s[i] for s in seconds.values()) for i in range(4)]
+    print('total   %9d  %5d  %5d  %4d' % tuple(total))
+
+
+def frames(records, width, height):
+    """Yields content of the panel after each transfer that changed it, as list of rows."""
+    white = b'\xff' * (width // 8)
+    panel = [white] * height
+
+    for t in transfers(records):
+        before = list(panel)
+        if t.cmd & CMD_CLR:
+            panel = [white] * height
+        for r in t.lines:
+            if r.data is None:
+                raise ValueError('trace has no line data, record it with SHARP_TRACE_DATA')
+            if 1 <= r.line <= height:
+                panel[r.line - 1] = r.data
+        if panel != before:
+            yield panel
+
+
+def write_pbm(path, panel, width, height):
+    with open(path, 'wb') as f:
+        f.write(b'P4\n%d %d\n' % (width, height))
+        for row in panel:                       # pixels are LOW active
+            f.write(bytes(b ^ 0xff for b in row))
+
+
+def write_frames(records, width, height, prefix):
+    """Writes a PBM frame after each transfer that changed the display, returns number of frames."""
+    count = 0
+    for panel in frames(records, width, height):
+        write_pbm('%s%04d.pbm' % (prefix, count), panel, width, height)
+        count += 1
+    return count
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode trace of SHARP Memory LCD traffic')
+    parser.add_argument('trace')
+    parser.add_argument('-o', '--output', help='prefix of reconstructed frames')
+    parser.add_argument('--binary', action='store_true', help='memory dump of sharpTrace from main.c')
+    parser.add_argument('--data', action='store_true', help='binary trace was built with SHARP_TRACE_DATA')
+    parser.add_argument('--spi', action='store_true', help='bytes sent by Linux backend to file')
+    parser.add_argument('--width', type=int, default=96, help='display width of binary trace or SPI file')
+    parser.add_argument('--height', type=int, default=96, help='display height of binary trace or SPI file')
+    parser.add_argument('--check', action='store_true', help='check trace against panel rules')
+    parser.add_argument('--vcom-min', type=int, default=VCOM_MIN, help='minimum time between VCOM inversions in ms')
+    parser.add_argument('--vcom-max', type=int, default=VCOM_MAX, help='maximum time between VCOM inversions in ms')
+    parser.add_argument('--bias-max', type=int, default=BIAS_MAX, help='maximum DC bias of a pixel in ms')
+    parser.add_argument('--bias-map', help='write peak DC bias per pixel as PGM image')
+    parser.add_argument('--sclk-max', type=int, default=SCLK_MAX, help='maximum SPI clock of SPI file in Hz')
+    parser.add_argument('--gpio', help='GPIO chip file of Linux backend, with --spi')
+    parser.add_argument('--cs', type=int, help='chip select line in GPIO chip file')
+    parser.add_argument('--extract', help='write bursts of chip select to SPI file')
+    args = parser.parse_args()
+    if (args.gpio is None) != (args.cs is None) or (args.gpio and not args.spi) or (args.extract and not args.gpio):
+        parser.error('--gpio and --cs go together, with --spi, and are needed by --extract')
+
+    errors = []
+    if args.binary:
+        records = read_binary(args.trace, args.data, args.width)
+        width, height = args.width, args.height
+    elif args.spi:
+        records = read_spi(args.trace, args.width, errors, args.sclk_max, args.gpio, args.cs)
+        if args.extract:
+            speed, bursts = read_bursts(args.trace)
+            write_bursts(args.extract, speed, select_bursts(bursts, read_gpio(args.gpio, []), args.cs))
+        width, height = args.width, args.height
+    else:
+        records, width, height = read_text(args.trace)
+
+    if not records:
+        sys.exit('%s: no trace records found' % args.trace)
+
+    profile(records, width)
+
+    if args.output:
+        try:
+            frames = write_frames(records, width, height, args.output)
+        except ValueError as e:
+            sys.exit(str(e))
+        print('%d frames written' % frames)
+
+    if args.check or args.bias_map:
+        if check(records, width, height, args.vcom_min, args.vcom_max, args.bias_max, args.bias_map, errors):
+            sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()